@@ -39,6 +39,7 @@ OBJS += $(NST_DIR)/source/core/NstVideoFilterNtscCfg.cpp				$(NST_DIR)/source/co
 
 # core/api
 OBJS += $(NST_DIR)/source/core/api/NstApiBarcodeReader.cpp  $(NST_DIR)/source/core/api/NstApiEmulator.cpp  $(NST_DIR)/source/core/api/NstApiMovie.cpp     $(NST_DIR)/source/core/api/NstApiTapeRecorder.cpp
+OBJS += $(NST_DIR)/source/core/api/NstApiBatch.cpp
 OBJS += $(NST_DIR)/source/core/api/NstApiCartridge.cpp      $(NST_DIR)/source/core/api/NstApiFds.cpp       $(NST_DIR)/source/core/api/NstApiNsf.cpp       $(NST_DIR)/source/core/api/NstApiUser.cpp
 OBJS += $(NST_DIR)/source/core/api/NstApiCheats.cpp         $(NST_DIR)/source/core/api/NstApiInput.cpp     $(NST_DIR)/source/core/api/NstApiRewinder.cpp  $(NST_DIR)/source/core/api/NstApiVideo.cpp
 OBJS += $(NST_DIR)/source/core/api/NstApiDipSwitches.cpp    $(NST_DIR)/source/core/api/NstApiMachine.cpp   $(NST_DIR)/source/core/api/NstApiSound.cpp
@@ -673,31 +673,17 @@ bool retro_load_game_special(unsigned, const struct retro_game_info *, size_t)
 
 size_t retro_serialize_size(void)
 {
-   std::stringstream ss;
-   if (machine->SaveState(ss, Api::Machine::NO_COMPRESSION))
-      return 0;
-   return ss.str().size();
+   return machine->GetStateSize();
 }
 
 bool retro_serialize(void *data, size_t size)
 {
-   std::stringstream ss;
-   if (machine->SaveState(ss, Api::Machine::NO_COMPRESSION))
-      return false;
-
-   std::string state = ss.str();
-   if (state.size() > size)
-      return false;
-
-   std::copy(state.begin(), state.end(), reinterpret_cast<char*>(data));
-   return true;
+   return !machine->SaveState(data, size);
 }
 
 bool retro_unserialize(const void *data, size_t size)
 {
-   std::stringstream ss(std::string(reinterpret_cast<const char*>(data),
-            reinterpret_cast<const char*>(data) + size));
-   return !machine->LoadState(ss);
+   return !machine->LoadState(data, size);
 }
 
 void *retro_get_memory_data(unsigned id)
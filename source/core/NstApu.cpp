@@ -112,6 +112,22 @@ namespace Nes
 			0x10, 0x1C, 0x20, 0x1E
 		};
 
+		const byte Apu::Square::forms[4][8] =
+		{
+			{0x1F,0x00,0x1F,0x1F,0x1F,0x1F,0x1F,0x1F},
+			{0x1F,0x00,0x00,0x1F,0x1F,0x1F,0x1F,0x1F},
+			{0x1F,0x00,0x00,0x00,0x00,0x1F,0x1F,0x1F},
+			{0x00,0x1F,0x1F,0x00,0x00,0x00,0x00,0x00}
+		};
+
+		const byte Apu::Triangle::pyramid[32] =
+		{
+			0x0,0x1,0x2,0x3,0x4,0x5,0x6,0x7,
+			0x8,0x9,0xA,0xB,0xC,0xD,0xE,0xF,
+			0xF,0xE,0xD,0xC,0xB,0xA,0x9,0x8,
+			0x7,0x6,0x5,0x4,0x3,0x2,0x1,0x0
+		};
+
 		const word Apu::Noise::lut[3][16] =
 		{
 			{
@@ -303,6 +319,20 @@ namespace Nes
 			return RESULT_OK;
 		}
 
+		Result Apu::SetResampling(const uint quality)
+		{
+			if (settings.resampling == quality)
+				return RESULT_NOP;
+
+			if (quality > Sound::Resampler::MAX_QUALITY)
+				return RESULT_ERR_INVALID_PARAM;
+
+			settings.resampling = quality;
+			UpdateSettings();
+
+			return RESULT_OK;
+		}
+
 		Result Apu::SetSampleBits(const uint bits)
 		{
 			if (settings.bits == bits)
@@ -399,12 +429,22 @@ namespace Nes
 			}
 		}
 
+		void Apu::EnableBandLimiting(const bool enable)
+		{
+			if (settings.bandLimited != enable)
+			{
+				settings.bandLimited = enable;
+				UpdateSettings();
+			}
+		}
+
 		void Apu::UpdateSettings()
 		{
-			cycles.Update( settings.rate, settings.speed, cpu );
+			cycles.Update( GetRenderRate(), settings.speed, cpu );
 			synchronizer.Reset( settings.speed, settings.rate, cpu );
 			dcBlocker.Reset();
 			buffer.Reset( settings.bits );
+			resampler.Reset( settings.resampling, GetRenderRate(), settings.rate );
 
 			Cycle rate; uint fixed;
 			CalculateOscillatorClock( rate, fixed );
@@ -430,15 +470,30 @@ namespace Nes
 			);
 		}
 
+		dword Apu::GetRenderRate() const
+		{
+			if (!settings.resampling)
+				return settings.rate;
+
+			return settings.rate * 2 > MIN_RESAMPLED_RATE ? settings.rate * 2 : MIN_RESAMPLED_RATE;
+		}
+
 		void Apu::Resync(const dword rate)
 		{
-			cycles.Update( rate, settings.speed, cpu );
-			ClearBuffers( false );
+			if (settings.resampling)
+			{
+				resampler.SetOutputRate( rate );
+			}
+			else
+			{
+				cycles.Update( rate, settings.speed, cpu );
+				ClearBuffers( false );
+			}
 		}
 
 		void Apu::CalculateOscillatorClock(Cycle& rate,uint& fixed) const
 		{
-			dword sampleRate = settings.rate;
+			dword sampleRate = GetRenderRate();
 
 			if (settings.transpose && settings.speed)
 				sampleRate = sampleRate * cpu.GetFps() / settings.speed;
@@ -479,6 +534,17 @@ namespace Nes
 				state.Begin( AsciiId<'F','R','M'>::V ).Write( data ).End();
 			}
 
+			if (state.Internal())
+			{
+				// run-ahead and rewinding reload every frame, keep the
+				// sample grid instead of restarting it at the CPU clock
+
+				state.Begin( AsciiId<'S','Y','N'>::V )
+				.Write32( cycles.rateCounter - cycles.fixed * cpu.GetCycles() )
+				.Write32( cycles.synthCounter - cycles.fixed * cpu.GetCycles() )
+				.End();
+			}
+
 			if (cycles.frameIrqClock != Cpu::CYCLE_MAX)
 			{
 				Cycle clock = cycles.frameIrqClock;
@@ -546,6 +612,7 @@ namespace Nes
 						ctrl = data[0] & STATUS_BITS;
 
 						cycles.rateCounter = cycles.fixed * cpu.GetCycles();
+						cycles.synthCounter = cycles.rateCounter;
 
 						cycles.frameCounter = cycles.fixed *
 						(
@@ -556,6 +623,12 @@ namespace Nes
 						break;
 					}
 
+					case AsciiId<'S','Y','N'>::V:
+
+						cycles.rateCounter = cycles.fixed * cpu.GetCycles() + state.Read32();
+						cycles.synthCounter = cycles.fixed * cpu.GetCycles() + state.Read32();
+						break;
+
 					case AsciiId<'I','R','Q'>::V:
 					{
 						State::Loader::Data<3> data( state );
@@ -703,9 +776,14 @@ namespace Nes
 
 		void NST_FASTCALL Apu::SyncOff(const Cycle target)
 		{
+			// Expansion chips step their waveforms in GetSample() only, which is never
+			// reached from here. Clock() is reserved for CPU-visible state (MMC5 length
+			// counters, FDS envelope gains) and is all that runs without a sound output.
+
 			NST_ASSERT( !(stream && settings.audible) && cycles.fixed );
 
 			cycles.rateCounter = target;
+			cycles.synthCounter = target;
 
 			while (cycles.frameCounter < target)
 				ClockFrameCounter();
@@ -719,10 +797,159 @@ namespace Nes
 			}
 		}
 
+		void NST_FASTCALL Apu::SyncBandLimited(const Cycle target)
+		{
+			NST_ASSERT( (stream && settings.audible) && (cycles.rate && cycles.fixed) && (cycles.extCounter == Cpu::CYCLE_MAX) );
+
+			while (cycles.frameCounter < target)
+			{
+				Synthesize( cycles.frameCounter );
+				ClockFrameCounter();
+			}
+
+			Synthesize( target );
+		}
+
+		void Apu::Synthesize(const Cycle target)
+		{
+			if (cycles.synthCounter < target)
+			{
+				// oscillators count in their own units of one output sample each,
+				// so both ends are mapped relative to the sample one step behind
+				// the next one to be rendered
+
+				const qaword rate = square[0].GetRate();
+				const Cycle from = cycles.synthCounter + cycles.rate;
+				const Cycle to = target + cycles.rate;
+
+				const Cycle begin = from > cycles.rateCounter ? rate * (from - cycles.rateCounter) / cycles.rate : 0;
+				const Cycle end = to > cycles.rateCounter ? rate * (to - cycles.rateCounter) / cycles.rate : 0;
+
+				SynthSquares( begin, end );
+				SynthTriangleNoise( begin, end );
+
+				cycles.synthCounter = target;
+			}
+		}
+
+		inline void Apu::SynthLevel(const uint group,const Cycle clock,const dword dac)
+		{
+			const idword level = idword
+			(
+				!dac  ? 0 :
+				group ? NLN_TND_0 / (NLN_TND_1 / dac + NLN_TND_2) :
+				NLN_SQ_0 / (NLN_SQ_1 / dac + NLN_SQ_2)
+			);
+
+			if (bandLimiter.levels[group] != level)
+			{
+				bandLimiter.steps.Add( clock, square[0].GetRate(), level - bandLimiter.levels[group] );
+				bandLimiter.levels[group] = level;
+			}
+		}
+
+		void Apu::SynthSquares(Cycle clock,const Cycle end)
+		{
+			for (;;)
+			{
+				SynthLevel( 0, clock, square[0].GetLevel() + square[1].GetLevel() );
+
+				Cycle next = end - clock;
+
+				for (uint i=0; i < 2; ++i)
+				{
+					if (square[i].IsActive() && Cycle(square[i].GetTimer()) < next)
+						next = square[i].GetTimer();
+				}
+
+				square[0].Step( next );
+				square[1].Step( next );
+
+				if ((clock += next) >= end)
+					break;
+			}
+		}
+
+		void Apu::SynthTriangleNoise(Cycle clock,const Cycle end)
+		{
+			const dword dmcLevel = dmc.GetLevel();
+
+			for (;;)
+			{
+				SynthLevel( 1, clock, triangle.GetLevel() + noise.GetLevel() + dmcLevel );
+
+				Cycle next = end - clock;
+
+				if (triangle.IsActive() && Cycle(triangle.GetTimer()) < next)
+					next = triangle.GetTimer();
+
+				if (noise.IsActive() && Cycle(noise.GetTimer()) < next)
+					next = noise.GetTimer();
+
+				triangle.Step( next );
+				noise.Step( next );
+
+				if ((clock += next) >= end)
+					break;
+			}
+		}
+
+		inline Apu::Channel::Sample Apu::GetBandLimitedSample()
+		{
+			return Clamp<Channel::OUTPUT_MIN,Channel::OUTPUT_MAX>( dcBlocker.Apply( bandLimiter.steps.Read() ) );
+		}
+
+		NST_NO_INLINE void Apu::RenderBandLimited()
+		{
+			const Cycle target = cpu.GetCycles() * cycles.fixed;
+
+			SyncBandLimited( target );
+
+			for (; cycles.rateCounter < target; cycles.rateCounter += cycles.rate)
+				buffer << GetBandLimitedSample();
+
+			bandLimiter.steps.Flush();
+		}
+
 		void Apu::BeginFrame(Sound::Output* output)
 		{
+			const Updater previous = updater;
+
 			stream = output;
-			updater = (output && settings.audible ? (cycles.extCounter == Cpu::CYCLE_MAX ? &Apu::SyncOn : &Apu::SyncOnExt) : &Apu::SyncOff);
+			updater = (output && settings.audible ? (cycles.extCounter == Cpu::CYCLE_MAX ? (settings.bandLimited ? &Apu::SyncBandLimited : &Apu::SyncOn) : &Apu::SyncOnExt) : &Apu::SyncOff);
+
+			if (updater == &Apu::SyncBandLimited && updater != previous)
+			{
+				const dword dac[2] =
+				{
+					square[0].GetLevel() + square[1].GetLevel(),
+					triangle.GetLevel() + noise.GetLevel() + dmc.GetLevel()
+				};
+
+				if (previous == &Apu::SyncOff && bandLimiter.active)
+				{
+					// silent frames in between (run-ahead, no output), keep the
+					// integrator and pending steps and only step to the current levels
+					SynthLevel( 0, 0, dac[0] );
+					SynthLevel( 1, 0, dac[1] );
+				}
+				else
+				{
+					cycles.synthCounter = cycles.rateCounter;
+
+					bandLimiter.Reset
+					(
+						dac[0] ? NLN_SQ_0 / (NLN_SQ_1 / dac[0] + NLN_SQ_2) : 0,
+						dac[1] ? NLN_TND_0 / (NLN_TND_1 / dac[1] + NLN_TND_2) : 0
+					);
+
+					bandLimiter.active = true;
+				}
+			}
+			else if (updater != &Apu::SyncBandLimited && updater != &Apu::SyncOff)
+			{
+				bandLimiter.active = false;
+			}
 		}
 
 		inline void Apu::Update(const Cycle target)
@@ -796,11 +1023,78 @@ namespace Nes
 							if (cycles.extCounter <= target)
 								cycles.extCounter = extChannel->Clock( cycles.extCounter, cycles.fixed, target );
 
+							if (updater == &Apu::SyncBandLimited)
+							{
+								const Cycle rateCounter = cycles.rateCounter;
+
+								do
+								{
+									Synthesize( cycles.rateCounter );
+									output << GetBandLimitedSample();
+									cycles.rateCounter += cycles.rate;
+								}
+								while (output);
+
+								cycles.synthCounter -= cycles.rateCounter - rateCounter;
+								cycles.rateCounter = rateCounter;
+							}
+							else
+							{
+								do
+								{
+									output << GetSample();
+								}
+								while (output);
+							}
+						}
+					}
+				}
+			}
+		}
+
+		template<typename T,bool STEREO>
+		void Apu::ResampleSound()
+		{
+			NST_ASSERT( (stream && settings.audible) && (cycles.rate && cycles.fixed) && resampler.GetQuality() );
+
+			(*this.*updater)( cpu.GetCycles() * cycles.fixed );
+
+			{
+				Sound::Buffer::Block block( Sound::Buffer::SIZE );
+				buffer >> block;
+				resampler << block;
+			}
+
+			for (uint i=0; i < 2; ++i)
+			{
+				if (stream->length[i] && stream->samples[i])
+				{
+					Sound::Buffer::Renderer<T,STEREO> output( stream->samples[i], stream->length[i], buffer.history );
+
+					if (resampler >> output)
+					{
+						if (updater == &Apu::SyncBandLimited)
+						{
+							const Cycle rateCounter = cycles.rateCounter;
+
 							do
 							{
-								output << GetSample();
+								Synthesize( cycles.rateCounter );
+								resampler << GetBandLimitedSample();
+								cycles.rateCounter += cycles.rate;
 							}
-							while (output);
+							while (resampler >> output);
+
+							cycles.synthCounter -= cycles.rateCounter - rateCounter;
+							cycles.rateCounter = rateCounter;
+						}
+						else
+						{
+							do
+							{
+								resampler << GetSample();
+							}
+							while (resampler >> output);
 						}
 					}
 				}
@@ -815,11 +1109,31 @@ namespace Nes
 			{
 				dword streamed = 0;
 
-				if (Sound::Output::lockCallback( *stream ))
+				if (updater == &Apu::SyncBandLimited)
+					RenderBandLimited();
+
+				if (cpu.GetCallbacks()[Sound::Output::lockCallback]( *stream ))
 				{
 					streamed = stream->length[0] + stream->length[1];
 
-					if (settings.bits == 16)
+					if (settings.resampling)
+					{
+						if (settings.bits == 16)
+						{
+							if (!settings.stereo)
+								ResampleSound<iword,false>();
+							else
+								ResampleSound<iword,true>();
+						}
+						else
+						{
+							if (!settings.stereo)
+								ResampleSound<byte,false>();
+							else
+								ResampleSound<byte,true>();
+						}
+					}
+					else if (settings.bits == 16)
 					{
 						if (!settings.stereo)
 							FlushSound<iword,false>();
@@ -834,7 +1148,7 @@ namespace Nes
 							FlushSound<byte,true>();
 					}
 
-					Sound::Output::unlockCallback( *stream );
+					cpu.GetCallbacks()[Sound::Output::unlockCallback]( *stream );
 				}
 
 				if (const dword rate = synchronizer.Clock( streamed, settings.rate, cpu ))
@@ -858,14 +1172,19 @@ namespace Nes
 
 			frame *= cycles.fixed;
 
+			if (updater != &Apu::SyncBandLimited)
+				cycles.synthCounter = cycles.rateCounter;
+
 			NST_ASSERT
 			(
 				cycles.rateCounter >= frame &&
+				cycles.synthCounter >= frame &&
 				cycles.frameCounter >= frame &&
 				cycles.extCounter >= frame
 			);
 
 			cycles.rateCounter -= frame;
+			cycles.synthCounter -= frame;
 			cycles.frameCounter -= frame;
 
 			if (cycles.extCounter != Cpu::CYCLE_MAX)
@@ -877,18 +1196,32 @@ namespace Nes
 		#endif
 
 		Apu::Settings::Settings()
-		: rate(44100), bits(16), speed(0), muted(false), transpose(false), stereo(false), audible(true)
+		: rate(44100), bits(16), speed(0), muted(false), transpose(false), stereo(false), audible(true), bandLimited(false), resampling(0)
 		{
 			for (uint i=0; i < MAX_CHANNELS; ++i)
 				volumes[i] = Channel::DEFAULT_VOLUME;
 		}
 
+		Apu::BandLimiter::BandLimiter()
+		: active(false)
+		{
+			Reset();
+		}
+
+		void Apu::BandLimiter::Reset(const idword squares,const idword tnd)
+		{
+			levels[0] = squares;
+			levels[1] = tnd;
+			steps.Reset();
+		}
+
 		Apu::Cycles::Cycles()
 		: fixed(1), rate(1) {}
 
 		void Apu::Cycles::Reset(const bool extChannel,const CpuModel model)
 		{
 			rateCounter = 0;
+			synthCounter = 0;
 			frameDivider = 0;
 			frameIrqClock = Cpu::CYCLE_MAX;
 			frameIrqRepeat = 0;
@@ -901,6 +1234,7 @@ namespace Nes
 		{
 			frameCounter /= fixed;
 			rateCounter /= fixed;
+			synthCounter /= fixed;
 
 			if (extCounter != Cpu::CYCLE_MAX)
 				extCounter /= fixed;
@@ -918,6 +1252,7 @@ namespace Nes
 
 			frameCounter *= fixed;
 			rateCounter *= fixed;
+			synthCounter *= fixed;
 
 			if (extCounter != Cpu::CYCLE_MAX)
 				extCounter *= fixed;
@@ -1194,7 +1529,7 @@ namespace Nes
 
 		dword Apu::Channel::GetSampleRate() const
 		{
-			return apu.settings.rate;
+			return apu.GetRenderRate();
 		}
 
 		bool Apu::Channel::IsMuted() const
@@ -1232,6 +1567,19 @@ namespace Nes
 			amp = 0;
 		}
 
+		inline uint Apu::Oscillator::Advance(const Cycle elapsed)
+		{
+			timer -= idword(elapsed);
+
+			if (timer > 0)
+				return 0;
+
+			const uint count = dword(-timer) / frequency + 1;
+			timer += idword(count * frequency);
+
+			return count;
+		}
+
 		void Apu::Oscillator::UpdateSettings(dword r,uint f)
 		{
 			NST_ASSERT( r && f );
@@ -1242,6 +1590,36 @@ namespace Nes
 			rate = r;
 		}
 
+		void Apu::Oscillator::SavePhase(State::Saver& state,const uint phase) const
+		{
+			// internal states only, regular ones restart the waveforms
+			state.Begin( AsciiId<'P','H','S'>::V ).Write32( timer ).Write32( frequency ).Write32( amp ).Write32( fixed ).Write16( phase ).End();
+		}
+
+		uint Apu::Oscillator::LoadPhase(State::Loader& state)
+		{
+			const idword t = state.Read32();
+			const dword q = state.Read32();
+			const dword a = state.Read32();
+			const dword f = state.Read32();
+			const uint phase = state.Read16();
+
+			if (f == fixed)
+			{
+				timer = t;
+				frequency = q;
+				amp = a;
+			}
+			else if (f)
+			{
+				timer = t / idword(f) * idword(fixed);
+				frequency = q / f * fixed;
+				amp = 0;
+			}
+
+			return phase;
+		}
+
 		void Apu::Square::Reset()
 		{
 			Oscillator::Reset();
@@ -1312,11 +1690,17 @@ namespace Nes
 			lengthCounter.SaveState( state, AsciiId<'L','E','N'>::V );
 			envelope.SaveState( state, AsciiId<'E','N','V'>::V );
 
+			if (state.Internal())
+				SavePhase( state, step );
+
 			state.End();
 		}
 
 		void Apu::Square::LoadState(State::Loader& state)
 		{
+			step = 0;
+			timer = 0;
+
 			while (const dword chunk = state.Begin())
 			{
 				switch (chunk)
@@ -1357,13 +1741,16 @@ namespace Nes
 
 						envelope.LoadState( state );
 						break;
+
+					case AsciiId<'P','H','S'>::V:
+
+						step = LoadPhase( state ) & 0x7;
+						break;
 				}
 
 				state.End();
 			}
 
-			step = 0;
-			timer = 0;
 			UpdateFrequency();
 		}
 
@@ -1485,14 +1872,6 @@ namespace Nes
 
 			if (active)
 			{
-				static const byte forms[4][8] =
-				{
-					{0x1F,0x00,0x1F,0x1F,0x1F,0x1F,0x1F,0x1F},
-					{0x1F,0x00,0x00,0x1F,0x1F,0x1F,0x1F,0x1F},
-					{0x1F,0x00,0x00,0x00,0x00,0x1F,0x1F,0x1F},
-					{0x00,0x1F,0x1F,0x00,0x00,0x00,0x00,0x00}
-				};
-
 				const byte* const NST_RESTRICT form = forms[duty];
 
 				if (timer >= 0)
@@ -1536,6 +1915,16 @@ namespace Nes
 			return amp;
 		}
 
+		NST_SINGLE_CALL dword Apu::Square::GetLevel() const
+		{
+			return active ? envelope.Volume() >> forms[duty][step] : 0;
+		}
+
+		NST_SINGLE_CALL void Apu::Square::Step(const Cycle elapsed)
+		{
+			step = (step + Advance( elapsed )) & 0x7;
+		}
+
 		#ifdef NST_MSVC_OPTIMIZE
 		#pragma optimize("s", on)
 		#endif
@@ -1598,11 +1987,17 @@ namespace Nes
 
 			lengthCounter.SaveState( state, AsciiId<'L','E','N'>::V );
 
+			if (state.Internal())
+				SavePhase( state, step );
+
 			state.End();
 		}
 
 		void Apu::Triangle::LoadState(State::Loader& state)
 		{
+			timer = 0;
+			step = 0;
+
 			while (const dword chunk = state.Begin())
 			{
 				switch (chunk)
@@ -1624,13 +2019,16 @@ namespace Nes
 
 						lengthCounter.LoadState( state );
 						break;
+
+					case AsciiId<'P','H','S'>::V:
+
+						step = LoadPhase( state ) & 0x1F;
+						break;
 				}
 
 				state.End();
 			}
 
-			timer = 0;
-			step = 0;
 			active = CanOutput();
 		}
 
@@ -1696,14 +2094,6 @@ namespace Nes
 
 			if (active)
 			{
-				static const byte pyramid[32] =
-				{
-					0x0,0x1,0x2,0x3,0x4,0x5,0x6,0x7,
-					0x8,0x9,0xA,0xB,0xC,0xD,0xE,0xF,
-					0xF,0xE,0xD,0xC,0xB,0xA,0x9,0x8,
-					0x7,0x6,0x5,0x4,0x3,0x2,0x1,0x0
-				};
-
 				dword sum = timer;
 				timer -= idword(rate);
 
@@ -1739,6 +2129,17 @@ namespace Nes
 			return amp;
 		}
 
+		NST_SINGLE_CALL dword Apu::Triangle::GetLevel() const
+		{
+			return pyramid[step] * outputVolume * 3;
+		}
+
+		NST_SINGLE_CALL void Apu::Triangle::Step(const Cycle elapsed)
+		{
+			if (active)
+				step = (step + Advance( elapsed )) & 0x1F;
+		}
+
 		inline uint Apu::Triangle::GetLengthCounter() const
 		{
 			return lengthCounter.GetCount();
@@ -1800,11 +2201,17 @@ namespace Nes
 			lengthCounter.SaveState( state, AsciiId<'L','E','N'>::V );
 			envelope.SaveState( state, AsciiId<'E','N','V'>::V );
 
+			if (state.Internal())
+				SavePhase( state, bits );
+
 			state.End();
 		}
 
 		void Apu::Noise::LoadState(State::Loader& state,const CpuModel model)
 		{
+			timer = 0;
+			bits = 1;
+
 			while (const dword chunk = state.Begin())
 			{
 				switch (chunk)
@@ -1827,13 +2234,19 @@ namespace Nes
 
 						envelope.LoadState( state );
 						break;
+
+					case AsciiId<'P','H','S'>::V:
+
+						bits = LoadPhase( state ) & 0x7FFF;
+
+						if (!bits)
+							bits = 1;
+						break;
 				}
 
 				state.End();
 			}
 
-			timer = 0;
-			bits = 1;
 			active = CanOutput();
 		}
 
@@ -1921,6 +2334,17 @@ namespace Nes
 			return 0;
 		}
 
+		NST_SINGLE_CALL dword Apu::Noise::GetLevel() const
+		{
+			return active && !(bits & 0x4000) ? envelope.Volume() * 2 : 0;
+		}
+
+		NST_SINGLE_CALL void Apu::Noise::Step(const Cycle elapsed)
+		{
+			for (uint count=Advance( elapsed ); count; --count)
+				bits = (bits << 1) | ((bits >> 14 ^ bits >> shifter) & 0x1);
+		}
+
 		inline uint Apu::Noise::GetLengthCounter() const
 		{
 			return lengthCounter.GetCount();
@@ -2251,6 +2675,11 @@ namespace Nes
 
 			dcBlocker.Reset();
 
+			if (updater == &Apu::SyncBandLimited)
+				bandLimiter.Reset( bandLimiter.levels[0], bandLimiter.levels[1] );
+
+			resampler.Clear();
+
 			buffer.Reset( settings.bits, false );
 		}
 
@@ -63,11 +63,13 @@ namespace Nes
 			Result SetSampleRate(dword);
 			Result SetSampleBits(uint);
 			Result SetSpeed(uint);
+			Result SetResampling(uint);
 			Result SetVolume(uint,uint);
 			uint   GetVolume(uint) const;
 			void   Mute(bool);
 			void   SetAutoTranspose(bool);
 			void   EnableStereo(bool);
+			void   EnableBandLimiting(bool);
 
 			void SaveState(State::Saver&,dword) const;
 			void LoadState(State::Loader&);
@@ -250,6 +252,7 @@ namespace Nes
 
 			void Reset(bool,bool);
 			void CalculateOscillatorClock(Cycle&,uint&) const;
+			dword GetRenderRate() const;
 			void Resync(dword);
 			NST_NO_INLINE void ClearBuffers(bool);
 
@@ -260,6 +263,7 @@ namespace Nes
 				STATUS_SEQUENCE_5_STEP  = 0x80,
 				STATUS_FRAME_IRQ_ENABLE = 0,
 				STATUS_BITS             = STATUS_NO_FRAME_IRQ|STATUS_SEQUENCE_5_STEP,
+				MIN_RESAMPLED_RATE      = 96000,
 				NLN_VOL                 = 192,
 				NLN_SQ_F                = 900,
 				NLN_SQ_0                = 9552UL * Channel::OUTPUT_MUL * NLN_VOL * (NLN_SQ_F/100),
@@ -295,9 +299,17 @@ namespace Nes
 
 			NST_NO_INLINE Channel::Sample GetSample();
 
-			void NST_FASTCALL SyncOn    (Cycle);
-			void NST_FASTCALL SyncOnExt (Cycle);
-			void NST_FASTCALL SyncOff   (Cycle);
+			void NST_FASTCALL SyncOn          (Cycle);
+			void NST_FASTCALL SyncOnExt       (Cycle);
+			void NST_FASTCALL SyncOff         (Cycle);
+			void NST_FASTCALL SyncBandLimited (Cycle);
+
+			inline void SynthLevel(uint,Cycle,dword);
+			void SynthSquares(Cycle,Cycle);
+			void SynthTriangleNoise(Cycle,Cycle);
+			void Synthesize(Cycle);
+			inline Channel::Sample GetBandLimitedSample();
+			NST_NO_INLINE void RenderBandLimited();
 
 			NST_NO_INLINE void ClockFrameIRQ(Cycle);
 			NST_NO_INLINE void ClockFrameCounter();
@@ -307,6 +319,9 @@ namespace Nes
 			template<typename T,bool STEREO>
 			void FlushSound();
 
+			template<typename T,bool STEREO>
+			void ResampleSound();
+
 			void UpdateSettings();
 			void UpdateVolumes();
 
@@ -320,6 +335,7 @@ namespace Nes
 				uint fixed;
 				Cycle rate;
 				Cycle rateCounter;
+				Cycle synthCounter;
 				Cycle frameCounter;
 				Cycle extCounter;
 				word frameDivider;
@@ -360,6 +376,8 @@ namespace Nes
 
 				void Reset();
 				void UpdateSettings(dword,uint);
+				void SavePhase(State::Saver&,uint) const;
+				uint LoadPhase(State::Loader&);
 
 				ibool active;
 				idword timer;
@@ -371,6 +389,22 @@ namespace Nes
 			public:
 
 				inline void ClearAmp();
+				inline uint Advance(Cycle);
+
+				bool IsActive() const
+				{
+					return active;
+				}
+
+				idword GetTimer() const
+				{
+					return timer;
+				}
+
+				Cycle GetRate() const
+				{
+					return rate;
+				}
 			};
 
 			class Square : public Oscillator
@@ -390,6 +424,9 @@ namespace Nes
 
 				dword GetSample();
 
+				NST_SINGLE_CALL dword GetLevel() const;
+				NST_SINGLE_CALL void Step(Cycle);
+
 				NST_SINGLE_CALL void ClockEnvelope();
 				NST_SINGLE_CALL void ClockSweep(uint);
 
@@ -425,6 +462,8 @@ namespace Nes
 				uint sweepIncrease;
 				word sweepShift;
 				word waveLength;
+
+				static const byte forms[4][8];
 			};
 
 			class Triangle : public Oscillator
@@ -445,6 +484,9 @@ namespace Nes
 
 				NST_SINGLE_CALL dword GetSample();
 
+				NST_SINGLE_CALL dword GetLevel() const;
+				NST_SINGLE_CALL void Step(Cycle);
+
 				NST_SINGLE_CALL void ClockLinearCounter();
 				NST_SINGLE_CALL void ClockLengthCounter();
 
@@ -477,6 +519,8 @@ namespace Nes
 				byte linearCtrl;
 				byte linearCounter;
 				Channel::LengthCounter lengthCounter;
+
+				static const byte pyramid[32];
 			};
 
 			class Noise : public Oscillator
@@ -495,6 +539,9 @@ namespace Nes
 
 				NST_SINGLE_CALL dword GetSample();
 
+				NST_SINGLE_CALL dword GetLevel() const;
+				NST_SINGLE_CALL void Step(Cycle);
+
 				NST_SINGLE_CALL void ClockEnvelope();
 				NST_SINGLE_CALL void ClockLengthCounter();
 
@@ -588,6 +635,13 @@ namespace Nes
 				}   dma;
 
 				static const word lut[3][16];
+
+			public:
+
+				dword GetLevel() const
+				{
+					return curSample;
+				}
 			};
 
 			struct Settings
@@ -601,9 +655,22 @@ namespace Nes
 				bool transpose;
 				bool stereo;
 				bool audible;
+				bool bandLimited;
+				byte resampling;
 				byte volumes[MAX_CHANNELS];
 			};
 
+			struct BandLimiter
+			{
+				BandLimiter();
+
+				void Reset(idword=0,idword=0);
+
+				idword levels[2];
+				bool active;
+				Sound::StepBuffer steps;
+			};
+
 			uint ctrl;
 			Updater updater;
 			Cpu& cpu;
@@ -617,6 +684,8 @@ namespace Nes
 			Channel::DcBlocker dcBlocker;
 			Sound::Output* stream;
 			Sound::Buffer buffer;
+			BandLimiter bandLimiter;
+			Sound::Resampler resampler;
 			Settings settings;
 
 		public:
@@ -636,6 +705,11 @@ namespace Nes
 				return settings.speed;
 			}
 
+			uint GetResampling() const
+			{
+				return settings.resampling;
+			}
+
 			bool IsAutoTransposing() const
 			{
 				return settings.transpose;
@@ -646,6 +720,11 @@ namespace Nes
 				return settings.stereo;
 			}
 
+			bool IsBandLimiting() const
+			{
+				return settings.bandLimited;
+			}
+
 			bool IsMuted() const
 			{
 				return settings.muted;
@@ -46,13 +46,32 @@ namespace Nes
 		Cartridge::ProfileEx::ProfileEx()
 		: nmt(NMT_DEFAULT), battery(false), wramAuto(false) {}
 
+		struct Cartridge::Rom
+		{
+			Rom()
+			: name(""), references(1) {}
+
+			Ram prg;
+			Ram chr;
+			ProfileEx profileEx;
+			Chips chips;
+			Boards::Board::Type type;
+			cstring name;
+			uint references; // clones are created and destroyed on one thread
+		};
+
 		Cartridge::Cartridge(Context& context)
-		: Image(CARTRIDGE), board(NULL), vs(NULL), favoredSystem(context.favoredSystem)
+		:
+		Image         (CARTRIDGE),
+		board         (NULL),
+		vs            (NULL),
+		rom           (new Rom),
+		savefile      (context.cpu.GetCallbacks()),
+		favoredSystem (context.favoredSystem),
+		clone         (false)
 		{
 			try
 			{
-				ProfileEx profileEx;
-
 				switch (Stream::In(&context.stream).Peek32())
 				{
 					case INES_ID:
@@ -63,12 +82,13 @@ namespace Nes
 							context.patch,
 							context.patchBypassChecksum,
 							context.patchResult,
-							prg,
-							chr,
+							rom->prg,
+							rom->chr,
 							context.favoredSystem,
 							profile,
-							profileEx,
-							context.database
+							rom->profileEx,
+							context.database,
+							context.cpu.GetCallbacks()
 						);
 						break;
 
@@ -80,12 +100,13 @@ namespace Nes
 							context.patch,
 							context.patchBypassChecksum,
 							context.patchResult,
-							prg,
-							chr,
+							rom->prg,
+							rom->chr,
 							context.favoredSystem,
 							profile,
-							profileEx,
-							context.database
+							rom->profileEx,
+							context.database,
+							context.cpu.GetCallbacks()
 						);
 						break;
 
@@ -97,11 +118,12 @@ namespace Nes
 							context.patch,
 							context.patchBypassChecksum,
 							context.patchResult,
-							prg,
-							chr,
+							rom->prg,
+							rom->chr,
 							context.favoredSystem,
 							context.askProfile,
-							profile
+							profile,
+							context.cpu.GetCallbacks()
 						);
 						break;
 				}
@@ -111,7 +133,7 @@ namespace Nes
 				else
 					context.result = RESULT_OK;
 
-				const Result result = SetupBoard( prg, chr, &board, &context, profile, profileEx, &prgCrc );
+				const Result result = SetupBoard( rom->prg, rom->chr, &board, &context, context.cpu.GetCallbacks(), profile, rom->profileEx, &prgCrc, rom );
 
 				if (NES_FAILED(result))
 					throw result;
@@ -138,7 +160,7 @@ namespace Nes
 				}
 
 				if (Cartridge::QueryExternalDevice( EXT_DIP_SWITCHES ))
-					Log::Flush( "Cartridge: DIP Switches present" NST_LINEBREAK );
+					Log::Flush( context.cpu.GetCallbacks(), "Cartridge: DIP Switches present" NST_LINEBREAK );
 			}
 			catch (...)
 			{
@@ -147,10 +169,70 @@ namespace Nes
 			}
 		}
 
+		Cartridge::Cartridge(const Cartridge& source,Cpu& cpu,Apu& apu,Ppu& ppu)
+		:
+		Image         (CARTRIDGE),
+		board         (NULL),
+		vs            (NULL),
+		rom           (source.rom),
+		profile       (source.profile),
+		prgCrc        (source.prgCrc),
+		savefile      (cpu.GetCallbacks()),
+		favoredSystem (source.favoredSystem),
+		clone         (true)
+		{
+			++rom->references;
+
+			try
+			{
+				const Log::Suppressor callbacks;
+
+				Ram prg( rom->prg );
+				Ram chr( rom->chr );
+				Chips chips( rom->chips );
+
+				Boards::Board::Context b
+				(
+					&cpu,
+					&apu,
+					&ppu,
+					prg,
+					chr,
+					rom->profileEx.trainer,
+					rom->type.GetNmt(),
+					rom->type.HasBattery(),
+					false,
+					chips,
+					callbacks
+				);
+
+				b.name = rom->name;
+				b.type = rom->type;
+
+				board = Boards::Board::Create( b );
+
+				if (profile.system.type == Profile::System::VS_UNISYSTEM)
+					vs = VsSystem::Create( cpu, ppu, static_cast<PpuModel>(profile.system.ppu), prgCrc );
+			}
+			catch (...)
+			{
+				Destroy();
+				throw;
+			}
+		}
+
+		Image* Cartridge::Clone(Cpu& cpu,Apu& apu,Ppu& ppu) const
+		{
+			return new Cartridge( *this, cpu, apu, ppu );
+		}
+
 		void Cartridge::Destroy()
 		{
 			VsSystem::Destroy( vs );
 			Boards::Board::Destroy( board );
+
+			if (!--rom->references)
+				delete rom;
 		}
 
 		Cartridge::~Cartridge()
@@ -160,29 +242,29 @@ namespace Nes
 
 		void Cartridge::ReadRomset(std::istream& stream,FavoredSystem favoredSystem,bool askSystem,Profile& profile)
 		{
-			Log::Suppressor logSupressor;
+			const Log::Suppressor callbacks;
 			Ram prg, chr;
 			ProfileEx profileEx;
-			Romset::Load( stream, NULL, false, NULL, prg, chr, favoredSystem, askSystem, profile, true );
-			SetupBoard( prg, chr, NULL, NULL, profile, profileEx, NULL, true );
+			Romset::Load( stream, NULL, false, NULL, prg, chr, favoredSystem, askSystem, profile, callbacks, true );
+			SetupBoard( prg, chr, NULL, NULL, callbacks, profile, profileEx, NULL, NULL, true );
 		}
 
 		void Cartridge::ReadInes(std::istream& stream,FavoredSystem favoredSystem,Profile& profile)
 		{
-			Log::Suppressor logSupressor;
+			const Log::Suppressor callbacks;
 			Ram prg, chr;
 			ProfileEx profileEx;
-			Ines::Load( stream, NULL, false, NULL, prg, chr, favoredSystem, profile, profileEx, NULL );
-			SetupBoard( prg, chr, NULL, NULL, profile, profileEx, NULL );
+			Ines::Load( stream, NULL, false, NULL, prg, chr, favoredSystem, profile, profileEx, NULL, callbacks );
+			SetupBoard( prg, chr, NULL, NULL, callbacks, profile, profileEx, NULL );
 		}
 
 		void Cartridge::ReadUnif(std::istream& stream,FavoredSystem favoredSystem,Profile& profile)
 		{
-			Log::Suppressor logSupressor;
+			const Log::Suppressor callbacks;
 			Ram prg, chr;
 			ProfileEx profileEx;
-			Unif::Load( stream, NULL, false, NULL, prg, chr, favoredSystem, profile, profileEx, NULL );
-			SetupBoard( prg, chr, NULL, NULL, profile, profileEx, NULL );
+			Unif::Load( stream, NULL, false, NULL, prg, chr, favoredSystem, profile, profileEx, NULL, callbacks );
+			SetupBoard( prg, chr, NULL, NULL, callbacks, profile, profileEx, NULL );
 		}
 
 		uint Cartridge::GetDesiredController(uint port) const
@@ -223,9 +305,11 @@ namespace Nes
 			Ram& chr,
 			Boards::Board** board,
 			const Context* const context,
+			const UserCallbacks& callbacks,
 			Profile& profile,
 			const ProfileEx& profileEx,
 			dword* const prgCrc,
+			Rom* const rom,
 			const bool readOnly
 		)
 		{
@@ -273,7 +357,8 @@ namespace Nes
 				nmt,
 				profileEx.battery || profile.board.HasWramBattery(),
 				profile.board.HasMmcBattery(),
-				chips
+				chips,
+				callbacks
 			);
 
 			if (profile.board.type.empty() || !b.DetectBoard( profile.board.type.c_str(), profile.board.GetWram() ))
@@ -349,6 +434,13 @@ namespace Nes
 			if (board)
 				*board = Boards::Board::Create( b );
 
+			if (rom)
+			{
+				rom->chips = chips;
+				rom->type = b.type;
+				rom->name = b.name;
+			}
+
 			return RESULT_OK;
 		}
 
@@ -367,7 +459,9 @@ namespace Nes
 				if (board)
 				{
 					board->Sync( Boards::Board::EVENT_POWER_OFF, NULL );
-					board->Save( savefile );
+
+					if (!clone)
+						board->Save( savefile );
 				}
 
 				return true;
@@ -63,6 +63,7 @@ namespace Nes
 
 		private:
 
+			Cartridge(const Cartridge&,Cpu&,Apu&,Ppu&);
 			~Cartridge();
 
 			struct ProfileEx
@@ -86,6 +87,7 @@ namespace Nes
 			};
 
 			class VsSystem;
+			struct Rom;
 
 			static Result SetupBoard
 			(
@@ -93,9 +95,11 @@ namespace Nes
 				Ram&,
 				Boards::Board**,
 				const Context*,
+				const UserCallbacks&,
 				Profile&,
 				const ProfileEx&,
 				dword*,
+				Rom* = NULL,
 				bool=false
 			);
 
@@ -113,15 +117,16 @@ namespace Nes
 			System GetDesiredSystem(Region,CpuModel*,PpuModel*) const;
 
 			ExternalDevice QueryExternalDevice(ExternalDeviceType);
+			Image* Clone(Cpu&,Apu&,Ppu&) const;
 
 			Boards::Board* board;
 			VsSystem* vs;
-			Ram prg;
-			Ram chr;
+			Rom* const rom;
 			Profile profile;
 			dword prgCrc;
 			File savefile;
 			const FavoredSystem favoredSystem;
+			const ibool clone;
 
 		public:
 
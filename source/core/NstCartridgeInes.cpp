@@ -69,6 +69,7 @@ namespace Nes
 			Ram& prg;
 			Ram& chr;
 			const ImageDatabase* const database;
+			const UserCallbacks& callbacks;
 			Patcher patcher;
 
 		public:
@@ -84,7 +85,8 @@ namespace Nes
 				const FavoredSystem f,
 				Profile& r,
 				ProfileEx& x,
-				const ImageDatabase* const d
+				const ImageDatabase* const d,
+				const UserCallbacks& u
 			)
 			:
 			stream        (&stdStreamImage),
@@ -94,6 +96,7 @@ namespace Nes
 			prg           (p),
 			chr           (c),
 			database      (d),
+			callbacks     (u),
 			patcher       (patchBypassChecksum)
 			{
 				NST_ASSERT( prg.Empty() && chr.Empty() );
@@ -144,10 +147,10 @@ namespace Nes
 				}
 
 				if (Load( prg, 16 ))
-					Log::Flush( "Ines: PRG-ROM was patched" NST_LINEBREAK );
+					Log::Flush( callbacks, "Ines: PRG-ROM was patched" NST_LINEBREAK );
 
 				if (Load( chr, 16 + prg.Size() ))
-					Log::Flush( "Ines: PRG-ROM was patched" NST_LINEBREAK );
+					Log::Flush( callbacks, "Ines: PRG-ROM was patched" NST_LINEBREAK );
 			}
 
 		private:
@@ -179,7 +182,7 @@ namespace Nes
 				if (patcher.Patch( header, header, 16 ))
 				{
 					profile.patched = true;
-					Log::Flush( "Ines: header was patched" NST_LINEBREAK );
+					Log::Flush( callbacks, "Ines: header was patched" NST_LINEBREAK );
 				}
 
 				Result result = ReadHeader( setup, header, 16 );
@@ -187,7 +190,7 @@ namespace Nes
 				if (NES_FAILED(result))
 					throw RESULT_ERR_CORRUPT_FILE;
 
-				Log log;
+				Log log( callbacks );
 
 				static const char title[] = "Ines: ";
 
@@ -503,7 +506,7 @@ namespace Nes
 			{
 				ImageDatabase::Entry entry;
 
-				if (database && database->Enabled())
+				if (database)
 				{
 					if (trainerSetup != TRAINER_NONE)
 						stream.Seek( TRAINER_LENGTH );
@@ -585,7 +588,8 @@ namespace Nes
 			const FavoredSystem favoredSystem,
 			Profile& profile,
 			ProfileEx& profileEx,
-			const ImageDatabase* const database
+			const ImageDatabase* const database,
+			const UserCallbacks& callbacks
 		)
 		{
 			Loader loader
@@ -599,7 +603,8 @@ namespace Nes
 				favoredSystem,
 				profile,
 				profileEx,
-				database
+				database,
+				callbacks
 			);
 
 			loader.Load();
@@ -52,7 +52,8 @@ namespace Nes
 				FavoredSystem,
 				Profile&,
 				ProfileEx&,
-				const ImageDatabase*
+				const ImageDatabase*,
+				const UserCallbacks&
 			);
 
 			static Result ReadHeader(Header&,const byte*,ulong);
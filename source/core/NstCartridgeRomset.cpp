@@ -71,6 +71,7 @@ namespace Nes
 			const bool askProfile;
 			const bool readOnly;
 			const bool patchBypassChecksum;
+			const UserCallbacks& callbacks;
 
 		public:
 
@@ -85,6 +86,7 @@ namespace Nes
 				const FavoredSystem f,
 				const bool a,
 				Profile& r,
+				const UserCallbacks& u,
 				const bool o
 			)
 			:
@@ -97,7 +99,8 @@ namespace Nes
 			patchResult         (e),
 			askProfile          (a),
 			readOnly            (o),
-			patchBypassChecksum (b)
+			patchBypassChecksum (b),
+			callbacks           (u)
 			{
 				NST_ASSERT( prg.Empty() && chr.Empty() );
 			}
@@ -713,7 +716,7 @@ namespace Nes
 						}
 					}
 
-					if (askProfile && Api::Cartridge::chooseProfileCallback)
+					if (askProfile && callbacks[Api::Cartridge::chooseProfileCallback])
 					{
 						std::vector<std::wstring> names( profiles.size() );
 
@@ -753,7 +756,7 @@ namespace Nes
 							);
 						}
 
-						const uint selected = Api::Cartridge::chooseProfileCallback( &profiles.front(), &names.front(), profiles.size() );
+						const uint selected = callbacks[Api::Cartridge::chooseProfileCallback]( &profiles.front(), &names.front(), profiles.size() );
 
 						if (selected < profiles.size())
 							bestMatch = profiles.begin() + selected;
@@ -902,7 +905,7 @@ namespace Nes
 					if (readOnly)
 						continue;
 
-					if (!Api::User::fileIoCallback)
+					if (!callbacks[Api::User::fileIoCallback])
 						throw RESULT_ERR_NOT_READY;
 
 					size = 0;
@@ -916,7 +919,7 @@ namespace Nes
 							throw RESULT_ERR_INVALID_FILE;
 
 						Loader loader( it->file.c_str(), rom.Mem(size), it->size );
-						Api::User::fileIoCallback( loader );
+						callbacks[Api::User::fileIoCallback]( loader );
 
 						if (!loader.Loaded())
 							throw RESULT_ERR_INVALID_FILE;
@@ -949,13 +952,13 @@ namespace Nes
 							if (patcher.Patch( prg.Mem(), prg.Mem(), prg.Size(), 16 ))
 							{
 								profile.patched = true;
-								Log::Flush( "Romset: PRG-ROM was patched" NST_LINEBREAK );
+								Log::Flush( callbacks, "Romset: PRG-ROM was patched" NST_LINEBREAK );
 							}
 
 							if (patcher.Patch( chr.Mem(), chr.Mem(), chr.Size(), 16 + prg.Size() ))
 							{
 								profile.patched = true;
-								Log::Flush( "Romset: CHR-ROM was patched" NST_LINEBREAK );
+								Log::Flush( callbacks, "Romset: CHR-ROM was patched" NST_LINEBREAK );
 							}
 						}
 					}
@@ -974,6 +977,7 @@ namespace Nes
 			const FavoredSystem favoredSystem,
 			const bool askProfile,
 			Profile& profile,
+			const UserCallbacks& callbacks,
 			const bool readOnly
 		)
 		{
@@ -988,6 +992,7 @@ namespace Nes
 				favoredSystem,
 				askProfile,
 				profile,
+				callbacks,
 				readOnly
 			);
 
@@ -50,6 +50,7 @@ namespace Nes
 				FavoredSystem,
 				bool,
 				Profile&,
+				const UserCallbacks&,
 				bool=false
 			);
 		};
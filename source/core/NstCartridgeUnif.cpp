@@ -69,11 +69,12 @@ namespace Nes
 			private:
 
 				byte chunks[80];
+				const UserCallbacks& callbacks;
 
 			public:
 
-				Context()
-				: system(SYSTEM_NTSC)
+				explicit Context(const UserCallbacks& c)
+				: system(SYSTEM_NTSC), callbacks(c)
 				{
 					std::memset( chunks, 0, sizeof(chunks) );
 				}
@@ -101,6 +102,7 @@ namespace Nes
 			Patcher patcher;
 			Result* const patchResult;
 			const ImageDatabase* const database;
+			const UserCallbacks& callbacks;
 
 		public:
 
@@ -115,7 +117,8 @@ namespace Nes
 				const FavoredSystem f,
 				Profile& r,
 				ProfileEx& x,
-				const ImageDatabase* const d
+				const ImageDatabase* const d,
+				const UserCallbacks& u
 			)
 			:
 			stream        (&stdStreamImage),
@@ -126,7 +129,8 @@ namespace Nes
 			chr           (c),
 			patcher       (patchBypassChecksum),
 			patchResult   (e),
-			database      (d)
+			database      (d),
+			callbacks     (u)
 			{
 				NST_ASSERT( prg.Empty() && chr.Empty() );
 
@@ -142,7 +146,7 @@ namespace Nes
 				ReadHeader();
 				ReadChunks();
 
-				if (database && database->Enabled())
+				if (database)
 				{
 					Checksum checksum;
 
@@ -168,13 +172,13 @@ namespace Nes
 						if (patcher.Patch( prg.Mem(), prg.Mem(), prg.Size(), 16 ))
 						{
 							profile.patched = true;
-							Log::Flush( "Unif: PRG-ROM was patched" NST_LINEBREAK );
+							Log::Flush( callbacks, "Unif: PRG-ROM was patched" NST_LINEBREAK );
 						}
 
 						if (patcher.Patch( chr.Mem(), chr.Mem(), chr.Size(), 16 + prg.Size() ))
 						{
 							profile.patched = true;
-							Log::Flush( "Unif: CHR-ROM was patched" NST_LINEBREAK );
+							Log::Flush( callbacks, "Unif: CHR-ROM was patched" NST_LINEBREAK );
 						}
 					}
 				}
@@ -189,7 +193,7 @@ namespace Nes
 
 				dword version = stream.Read32();
 
-				Log() << "Unif: revision " << version << NST_LINEBREAK;
+				Log( callbacks ) << "Unif: revision " << version << NST_LINEBREAK;
 
 				byte reserved[HEADER_RESERVED_LENGTH];
 				stream.Read( reserved );
@@ -200,7 +204,7 @@ namespace Nes
 
 					if (reserved[i])
 					{
-						Log() << "Unif: warning, unknown header data" NST_LINEBREAK;
+						Log( callbacks ) << "Unif: warning, unknown header data" NST_LINEBREAK;
 						break;
 					}
 				}
@@ -208,7 +212,7 @@ namespace Nes
 
 			void ReadChunks()
 			{
-				Context context;
+				Context context( callbacks );
 
 				while (!stream.Eof())
 				{
@@ -441,7 +445,7 @@ namespace Nes
 				stream.Read( dumper.agent, DUMPER_AGENT_LENGTH );
 				dumper.agent[DUMPER_AGENT_LENGTH-1] = '\0';
 
-				Log log;
+				Log log( callbacks );
 
 				if (*dumper.name)
 					log << "Unif: dumped by: " << dumper.name << NST_LINEBREAK;
@@ -463,19 +467,19 @@ namespace Nes
 					case 0:
 
 						context.system = Context::SYSTEM_NTSC;
-						Log::Flush( "Unif: NTSC system" NST_LINEBREAK );
+						Log::Flush( callbacks, "Unif: NTSC system" NST_LINEBREAK );
 						break;
 
 					case 1:
 
 						context.system = Context::SYSTEM_PAL;
-						Log::Flush( "Unif: PAL system" NST_LINEBREAK );
+						Log::Flush( callbacks, "Unif: PAL system" NST_LINEBREAK );
 						break;
 
 					default:
 
 						context.system = Context::SYSTEM_BOTH;
-						Log::Flush( "Unif: dual system" NST_LINEBREAK );
+						Log::Flush( callbacks, "Unif: dual system" NST_LINEBREAK );
 						break;
 				}
 
@@ -485,7 +489,7 @@ namespace Nes
 			dword ReadBattery()
 			{
 				profileEx.battery = true;
-				Log::Flush( "Unif: battery present" NST_LINEBREAK );
+				Log::Flush( callbacks, "Unif: battery present" NST_LINEBREAK );
 				return 0;
 			}
 
@@ -504,12 +508,12 @@ namespace Nes
 			{
 				switch (stream.Read8())
 				{
-					case 0: profileEx.nmt = ProfileEx::NMT_HORIZONTAL;   Log::Flush( "Unif: horizontal mirroring"        NST_LINEBREAK ); break;
-					case 1: profileEx.nmt = ProfileEx::NMT_VERTICAL;     Log::Flush( "Unif: vertical mirroring"          NST_LINEBREAK ); break;
+					case 0: profileEx.nmt = ProfileEx::NMT_HORIZONTAL;   Log::Flush( callbacks, "Unif: horizontal mirroring"        NST_LINEBREAK ); break;
+					case 1: profileEx.nmt = ProfileEx::NMT_VERTICAL;     Log::Flush( callbacks, "Unif: vertical mirroring"          NST_LINEBREAK ); break;
 					case 2:
-					case 3: profileEx.nmt = ProfileEx::NMT_SINGLESCREEN; Log::Flush( "Unif: single-screen mirroring"     NST_LINEBREAK ); break;
-					case 4: profileEx.nmt = ProfileEx::NMT_FOURSCREEN;   Log::Flush( "Unif: four-screen mirroring"       NST_LINEBREAK ); break;
-					case 5: profileEx.nmt = ProfileEx::NMT_CONTROLLED;   Log::Flush( "Unif: mapper controlled mirroring" NST_LINEBREAK ); break;
+					case 3: profileEx.nmt = ProfileEx::NMT_SINGLESCREEN; Log::Flush( callbacks, "Unif: single-screen mirroring"     NST_LINEBREAK ); break;
+					case 4: profileEx.nmt = ProfileEx::NMT_FOURSCREEN;   Log::Flush( callbacks, "Unif: four-screen mirroring"       NST_LINEBREAK ); break;
+					case 5: profileEx.nmt = ProfileEx::NMT_CONTROLLED;   Log::Flush( callbacks, "Unif: mapper controlled mirroring" NST_LINEBREAK ); break;
 				}
 
 				return 1;
@@ -525,7 +529,7 @@ namespace Nes
 					rom.crc[i] = (c < 0xA ? '0' + c : 'A' + (c - 0xA) );
 				}
 
-				Log() << "Unif: "
+				Log( callbacks ) << "Unif: "
                       << (type ? "CHR-ROM " : "PRG-ROM ")
                       << char(index < 10 ? index + '0' : index-10 + 'A')
                       << " CRC: "
@@ -539,7 +543,7 @@ namespace Nes
 			{
 				NST_ASSERT( type < 2 && index < 16 );
 
-				Log() << "Unif: "
+				Log( callbacks ) << "Unif: "
                       << (type ? "CHR-ROM " : "PRG-ROM ")
                       << char(index < 10 ? index + '0' : index-10 + 'A')
                       << " size: "
@@ -559,7 +563,7 @@ namespace Nes
 					roms[index].truncated = length - available;
 					length = available;
 
-					Log() << "Unif: warning, "
+					Log( callbacks ) << "Unif: warning, "
                           << (type ? "CHR-ROM " : "PRG-ROM ")
                           << char(index < 10 ? index + '0' : index-10 + 'A')
                           << " truncated to: "
@@ -578,7 +582,7 @@ namespace Nes
 
 			dword ReadController()
 			{
-				Log log;
+				Log log( callbacks );
 
 				log << "Unif: controllers: ";
 
@@ -646,18 +650,18 @@ namespace Nes
 				return 1;
 			}
 
-			static dword ReadChrRam()
+			dword ReadChrRam() const
 			{
-				Log::Flush( "Unif: CHR is writable" NST_LINEBREAK );
+				Log::Flush( callbacks, "Unif: CHR is writable" NST_LINEBREAK );
 				return 0;
 			}
 
-			static dword ReadUnknown(dword id)
+			dword ReadUnknown(dword id) const
 			{
 				NST_DEBUG_MSG("unknown unif chunk");
 
 				char name[5];
-				Log() << "Unif: warning, skipping unknown chunk: \"" << ChunkName(name,id) << "\"" NST_LINEBREAK;
+				Log( callbacks ) << "Unif: warning, skipping unknown chunk: \"" << ChunkName(name,id) << "\"" NST_LINEBREAK;
 
 				return 0;
 			}
@@ -674,7 +678,8 @@ namespace Nes
 			const FavoredSystem favoredSystem,
 			Profile& profile,
 			ProfileEx& profileEx,
-			const ImageDatabase* const database
+			const ImageDatabase* const database,
+			const UserCallbacks& callbacks
 		)
 		{
 			Loader loader
@@ -688,7 +693,8 @@ namespace Nes
 				favoredSystem,
 				profile,
 				profileEx,
-				database
+				database,
+				callbacks
 			);
 
 			loader.Load();
@@ -713,7 +719,7 @@ namespace Nes
 			else
 			{
 				char name[5];
-				Log() << "Unif: warning, duplicate chunk: \"" << ChunkName(name,chunk) << "\" ignored" NST_LINEBREAK;
+				Log( callbacks ) << "Unif: warning, duplicate chunk: \"" << ChunkName(name,chunk) << "\" ignored" NST_LINEBREAK;
 
 				return false;
 			}
@@ -729,7 +735,7 @@ namespace Nes
 			const dword count = stream.Read( *string );
 
 			if (string->Size() > 1)
-				Log() << logtext << string->Begin() << NST_LINEBREAK;
+				Log( callbacks ) << logtext << string->Begin() << NST_LINEBREAK;
 
 			return count;
 		}
@@ -50,7 +50,8 @@ namespace Nes
 				FavoredSystem,
 				Profile&,
 				ProfileEx&,
-				const ImageDatabase*
+				const ImageDatabase*,
+				const UserCallbacks&
 			);
 		};
 	}
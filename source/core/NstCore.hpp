@@ -122,6 +122,14 @@
    #define NST_NO_INLINE __attribute__((noinline))
    #endif
 
+   #if !defined(NST_COMPUTED_GOTO) && !defined(NST_NO_COMPUTED_GOTO)
+   #define NST_COMPUTED_GOTO
+   #endif
+
+   #if !defined(NST_MM_INTRINSICS) && defined(__SSE2__)
+   #define NST_MM_INTRINSICS
+   #endif
+
 //	Commenting this fixes a lot of warnings on newer versions of GCC
 //   #define NST_SINGLE_CALL __attribute__((always_inline))
 
@@ -147,6 +155,10 @@
 
 #define NST_NOP() ((void)0)
 
+#if defined(NST_MM_INTRINSICS) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define NST_SSE2
+#endif
+
 #ifndef NST_FORCE_INLINE
 #define NST_FORCE_INLINE inline
 #endif
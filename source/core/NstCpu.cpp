@@ -32,8 +32,6 @@ namespace Nes
 {
 	namespace Core
 	{
-		dword Cpu::logged = 0;
-
 		void (Cpu::*const Cpu::opcodes[0x100])() =
 		{
 			&Cpu::op0x00, &Cpu::op0x01, &Cpu::op0x02, &Cpu::op0x03,
@@ -149,9 +147,10 @@ namespace Nes
 
 		Cpu::Cpu()
 		:
-		model ( CPU_RP2A03 ),
-		apu   ( *this ),
-		map   ( this, &Cpu::Peek_Overflow, &Cpu::Poke_Overflow )
+		model   ( CPU_RP2A03 ),
+		ramBank ( ram.mem ),
+		apu     ( *this ),
+		map     ( this, &Cpu::Peek_Overflow, &Cpu::Poke_Overflow )
 		{
 			cycles.UpdateTable( GetModel() );
 			Reset( false, false );
@@ -206,8 +205,10 @@ namespace Nes
 			cycles.frame  = (model == CPU_RP2A03 ? PPU_RP2C02_HVSYNC : model == CPU_RP2A07 ? PPU_RP2C07_HVSYNC : PPU_DENDY_HVSYNC);
 
 			interrupt.Reset();
+			idle.Reset();
 			hooks.Clear();
 			linker.Clear();
+			map.Reset();
 
 			if (on)
 			{
@@ -219,6 +220,11 @@ namespace Nes
 				map( 0xFFFC         ).Set( this, &Cpu::Peek_Jam_1,      &Cpu::Poke_Nop        );
 				map( 0xFFFD         ).Set( this, &Cpu::Peek_Jam_2,      &Cpu::Poke_Nop        );
 
+				map.SetDirect( 0x0000, 0x07FF, &ramBank, RAM_SIZE-1 );
+				map.SetDirect( 0x0800, 0x0FFF, &ramBank, RAM_SIZE-1 );
+				map.SetDirect( 0x1000, 0x17FF, &ramBank, RAM_SIZE-1 );
+				map.SetDirect( 0x1800, 0x1FFF, &ramBank, RAM_SIZE-1 );
+
 				apu.Reset( hard );
 			}
 			else
@@ -486,7 +492,7 @@ namespace Nes
 			if (!(logged & which))
 			{
 				logged |= which;
-				Api::User::eventCallback( Api::User::EVENT_CPU_UNOFFICIAL_OPCODE, code );
+				callbacks[Api::User::eventCallback]( Api::User::EVENT_CPU_UNOFFICIAL_OPCODE, code );
 			}
 		}
 
@@ -607,6 +613,7 @@ namespace Nes
 						else
 							chain = entry;
 
+						map.Invalidate( address, address );
 						map(address) = port;
 
 						return it;
@@ -633,6 +640,7 @@ namespace Nes
 			entry->next = new Chain( map[address], address );
 			entry->next->next = NULL;
 
+			map.Invalidate( address, address );
 			map(address) = port;
 
 			if (Chain* it = chain)
@@ -664,7 +672,10 @@ namespace Nes
 					delete next;
 
 					if (map(address) == port)
+					{
+						map.Invalidate( address, address );
 						map(address) = *it;
+					}
 
 					if (it->level == 0)
 					{
@@ -732,9 +743,104 @@ namespace Nes
 			low = 0;
 		}
 
+		Cpu::Idle::Idle()
+		: enabled(false)
+		{
+			Reset();
+		}
+
+		void Cpu::Idle::Reset()
+		{
+			loop = false;
+			head = ~0U;
+			count = 0;
+			a = 0;
+			x = 0;
+			y = 0;
+			nz = 0;
+			c = 0;
+			v = 0;
+		}
+
 		template<typename T,typename U>
 		Cpu::IoMap::IoMap(Cpu* cpu,T peek,U poke)
-		: Io::Map<SIZE_64K>( cpu, peek, poke ) {}
+		: Io::Map<SIZE_64K>( cpu, peek, poke )
+		{
+			Reset();
+		}
+
+		void Cpu::IoMap::Reset()
+		{
+			for (uint i=0; i < DIRECT_PAGES; ++i)
+			{
+				pages[i].bank = NULL;
+				pages[i].mask = 0;
+				sources[i].bank = NULL;
+				sources[i].mask = 0;
+			}
+
+			pages[DIRECT_PAGES].bank = NULL;
+			pages[DIRECT_PAGES].mask = 0;
+
+			dirty = false;
+		}
+
+		bool Cpu::IoMap::IsDirect(const uint address) const
+		{
+			NST_ASSERT( address < FULL_SIZE );
+			return pages[address >> DIRECT_SHIFT].bank != NULL;
+		}
+
+		void Cpu::IoMap::Invalidate(const Address first,const Address last)
+		{
+			NST_ASSERT( first <= last && last < SIZE );
+
+			for (uint i=first >> DIRECT_SHIFT, n=last >> DIRECT_SHIFT; i <= n; ++i)
+			{
+				pages[i].bank = NULL;
+
+				if (sources[i].bank)
+					dirty = true;
+			}
+		}
+
+		void Cpu::IoMap::SetDirect(const Address first,const Address last,const byte* const* const bank,const uint mask)
+		{
+			NST_ASSERT( bank && !(first & ((1U << DIRECT_SHIFT)-1)) && !((last+1) & ((1U << DIRECT_SHIFT)-1)) && last < SIZE );
+
+			for (uint i=first >> DIRECT_SHIFT, n=last >> DIRECT_SHIFT; i <= n; ++i)
+			{
+				sources[i].bank = bank;
+				sources[i].mask = mask;
+				sources[i].port = ports[i << DIRECT_SHIFT];
+				pages[i].bank = NULL;
+			}
+
+			dirty = true;
+		}
+
+		void Cpu::IoMap::Update()
+		{
+			if (dirty)
+			{
+				dirty = false;
+
+				for (uint i=0; i < DIRECT_PAGES; ++i)
+				{
+					if (sources[i].bank && !pages[i].bank)
+					{
+						const Io::Port* port = ports + (i << DIRECT_SHIFT);
+						const Io::Port* const end = port + (1U << DIRECT_SHIFT);
+
+						while (port != end && port->SameReader( sources[i].port ))
+							++port;
+
+						if (port == end)
+							pages[i] = sources[i];
+					}
+				}
+			}
+		}
 
 		#ifdef NST_MSVC_OPTIMIZE
 		#pragma optimize("", on)
@@ -743,13 +849,19 @@ namespace Nes
 		inline uint Cpu::IoMap::Peek8(const uint address) const
 		{
 			NST_ASSERT( address < FULL_SIZE );
+
+			const Page& page = pages[address >> DIRECT_SHIFT];
+
+			if (page.bank)
+				return (*page.bank)[address & page.mask];
+
 			return ports[address].Peek( address );
 		}
 
 		inline uint Cpu::IoMap::Peek16(const uint address) const
 		{
 			NST_ASSERT( address < FULL_SIZE-1 );
-			return ports[address].Peek( address ) | ports[address + 1].Peek( address + 1 ) << 8;
+			return Peek8( address ) | Peek8( address + 1 ) << 8;
 		}
 
 		inline void Cpu::IoMap::Poke8(const uint address,const uint data) const
@@ -1795,7 +1907,7 @@ namespace Nes
 				jammed = true;
 				interrupt.Reset();
 				NST_DEBUG_MSG("6502 JAM");
-				Api::User::eventCallback( Api::User::EVENT_CPU_JAM );
+				callbacks[Api::User::eventCallback]( Api::User::EVENT_CPU_JAM );
 			}
 		}
 
@@ -1828,6 +1940,8 @@ namespace Nes
 		{
 			NST_ASSERT( interrupt.irqClock == CYCLE_MAX );
 
+			idle.head = ~0U;
+
 			if (!jammed)
 			{
 				Push16( pc );
@@ -1870,6 +1984,8 @@ namespace Nes
 			NST_VERIFY( cycles.count < cycles.frame );
 
 			apu.BeginFrame( sound );
+			map.Update();
+			idle.head = ~0U;
 
 			Clock();
 
@@ -1937,6 +2053,8 @@ namespace Nes
 			cycles.round = clock;
 		}
 
+	#ifdef NST_NO_THREADED_CPU
+
 		inline void Cpu::ExecuteOp()
 		{
 			cycles.offset = cycles.count;
@@ -1945,17 +2063,37 @@ namespace Nes
 
 		void Cpu::Run0()
 		{
-			do
+			if (idle.enabled)
 			{
 				do
 				{
-					ExecuteOp();
+					do
+					{
+						ExecuteOp();
+
+						if ((opcode & 0x1F) == 0x10 || opcode == 0x4C)
+							IdleLoop();
+					}
+					while (cycles.count < cycles.round);
+
+					Clock();
 				}
-				while (cycles.count < cycles.round);
+				while (cycles.count < cycles.frame);
+			}
+			else
+			{
+				do
+				{
+					do
+					{
+						ExecuteOp();
+					}
+					while (cycles.count < cycles.round);
 
-				Clock();
+					Clock();
+				}
+				while (cycles.count < cycles.frame);
 			}
-			while (cycles.count < cycles.frame);
 		}
 
 		void Cpu::Run1()
@@ -2004,6 +2142,8 @@ namespace Nes
 			while (cycles.count < cycles.frame);
 		}
 
+	#endif
+
 		uint Cpu::Peek(const uint address) const
 		{
 			return map.Peek8( address );
@@ -2365,6 +2505,268 @@ namespace Nes
 		#pragma optimize("", on)
 		#endif
 
+		void Cpu::IdleLoop()
+		{
+			if (pc != idle.head)
+			{
+				idle.head = pc;
+				idle.loop = ScanIdleLoop( pc );
+
+				if (!idle.loop)
+					return;
+			}
+			else if (!idle.loop)
+			{
+				return;
+			}
+			else if
+			(
+				idle.a == a && idle.x == x && idle.y == y &&
+				idle.nz == flags.nz && idle.c == flags.c && idle.v == flags.v &&
+				cycles.count < cycles.round
+			)
+			{
+				const Cycle period = cycles.count - idle.count;
+				cycles.count += (cycles.round - 1 - cycles.count) / period * period;
+			}
+
+			idle.count = cycles.count;
+			idle.a = a;
+			idle.x = x;
+			idle.y = y;
+			idle.nz = flags.nz;
+			idle.c = flags.c;
+			idle.v = flags.v;
+		}
+
+		bool Cpu::ScanIdleLoop(const uint head) const
+		{
+			for (uint address=head; address < head + Idle::MAX_LOOP_SIZE; )
+			{
+				if (!map.IsDirect( address ) || !map.IsDirect( address + 2 ))
+					return false;
+
+				const uint op = map.Peek8( address );
+
+				switch (op)
+				{
+					case 0xEA:
+
+						address += 1;
+						break;
+
+					case 0x09: case 0x29: case 0xA0: case 0xA2: case 0xA9: case 0xC0: case 0xC9: case 0xE0:
+					case 0x05: case 0x24: case 0x25: case 0xA4: case 0xA5: case 0xA6: case 0xC4: case 0xC5: case 0xE4:
+
+						address += 2;
+						break;
+
+					case 0x0D: case 0x2C: case 0x2D: case 0xAC: case 0xAD: case 0xAE: case 0xCC: case 0xCD: case 0xEC:
+
+						if (!map.IsDirect( map.Peek16( address + 1 ) ))
+							return false;
+
+						address += 3;
+						break;
+
+					case 0x4C:
+
+						return map.Peek16( address + 1 ) == head;
+
+					default:
+
+						if ((op & 0x1F) == 0x10)
+							return ((address + 2 + sign_extend_8(uint(map.Peek8( address + 1 )))) & 0xFFFF) == head;
+
+						return false;
+				}
+			}
+
+			return false;
+		}
+
+		////////////////////////////////////////////////////////////////////////////////////////
+		// threaded dispatch
+		////////////////////////////////////////////////////////////////////////////////////////
+
+	#ifndef NST_NO_THREADED_CPU
+
+		#define NES_OPCODES(f_) \
+			f_(0x00) f_(0x01) f_(0x02) f_(0x03) f_(0x04) f_(0x05) f_(0x06) f_(0x07) \
+			f_(0x08) f_(0x09) f_(0x0A) f_(0x0B) f_(0x0C) f_(0x0D) f_(0x0E) f_(0x0F) \
+			f_(0x10) f_(0x11) f_(0x12) f_(0x13) f_(0x14) f_(0x15) f_(0x16) f_(0x17) \
+			f_(0x18) f_(0x19) f_(0x1A) f_(0x1B) f_(0x1C) f_(0x1D) f_(0x1E) f_(0x1F) \
+			f_(0x20) f_(0x21) f_(0x22) f_(0x23) f_(0x24) f_(0x25) f_(0x26) f_(0x27) \
+			f_(0x28) f_(0x29) f_(0x2A) f_(0x2B) f_(0x2C) f_(0x2D) f_(0x2E) f_(0x2F) \
+			f_(0x30) f_(0x31) f_(0x32) f_(0x33) f_(0x34) f_(0x35) f_(0x36) f_(0x37) \
+			f_(0x38) f_(0x39) f_(0x3A) f_(0x3B) f_(0x3C) f_(0x3D) f_(0x3E) f_(0x3F) \
+			f_(0x40) f_(0x41) f_(0x42) f_(0x43) f_(0x44) f_(0x45) f_(0x46) f_(0x47) \
+			f_(0x48) f_(0x49) f_(0x4A) f_(0x4B) f_(0x4C) f_(0x4D) f_(0x4E) f_(0x4F) \
+			f_(0x50) f_(0x51) f_(0x52) f_(0x53) f_(0x54) f_(0x55) f_(0x56) f_(0x57) \
+			f_(0x58) f_(0x59) f_(0x5A) f_(0x5B) f_(0x5C) f_(0x5D) f_(0x5E) f_(0x5F) \
+			f_(0x60) f_(0x61) f_(0x62) f_(0x63) f_(0x64) f_(0x65) f_(0x66) f_(0x67) \
+			f_(0x68) f_(0x69) f_(0x6A) f_(0x6B) f_(0x6C) f_(0x6D) f_(0x6E) f_(0x6F) \
+			f_(0x70) f_(0x71) f_(0x72) f_(0x73) f_(0x74) f_(0x75) f_(0x76) f_(0x77) \
+			f_(0x78) f_(0x79) f_(0x7A) f_(0x7B) f_(0x7C) f_(0x7D) f_(0x7E) f_(0x7F) \
+			f_(0x80) f_(0x81) f_(0x82) f_(0x83) f_(0x84) f_(0x85) f_(0x86) f_(0x87) \
+			f_(0x88) f_(0x89) f_(0x8A) f_(0x8B) f_(0x8C) f_(0x8D) f_(0x8E) f_(0x8F) \
+			f_(0x90) f_(0x91) f_(0x92) f_(0x93) f_(0x94) f_(0x95) f_(0x96) f_(0x97) \
+			f_(0x98) f_(0x99) f_(0x9A) f_(0x9B) f_(0x9C) f_(0x9D) f_(0x9E) f_(0x9F) \
+			f_(0xA0) f_(0xA1) f_(0xA2) f_(0xA3) f_(0xA4) f_(0xA5) f_(0xA6) f_(0xA7) \
+			f_(0xA8) f_(0xA9) f_(0xAA) f_(0xAB) f_(0xAC) f_(0xAD) f_(0xAE) f_(0xAF) \
+			f_(0xB0) f_(0xB1) f_(0xB2) f_(0xB3) f_(0xB4) f_(0xB5) f_(0xB6) f_(0xB7) \
+			f_(0xB8) f_(0xB9) f_(0xBA) f_(0xBB) f_(0xBC) f_(0xBD) f_(0xBE) f_(0xBF) \
+			f_(0xC0) f_(0xC1) f_(0xC2) f_(0xC3) f_(0xC4) f_(0xC5) f_(0xC6) f_(0xC7) \
+			f_(0xC8) f_(0xC9) f_(0xCA) f_(0xCB) f_(0xCC) f_(0xCD) f_(0xCE) f_(0xCF) \
+			f_(0xD0) f_(0xD1) f_(0xD2) f_(0xD3) f_(0xD4) f_(0xD5) f_(0xD6) f_(0xD7) \
+			f_(0xD8) f_(0xD9) f_(0xDA) f_(0xDB) f_(0xDC) f_(0xDD) f_(0xDE) f_(0xDF) \
+			f_(0xE0) f_(0xE1) f_(0xE2) f_(0xE3) f_(0xE4) f_(0xE5) f_(0xE6) f_(0xE7) \
+			f_(0xE8) f_(0xE9) f_(0xEA) f_(0xEB) f_(0xEC) f_(0xED) f_(0xEE) f_(0xEF) \
+			f_(0xF0) f_(0xF1) f_(0xF2) f_(0xF3) f_(0xF4) f_(0xF5) f_(0xF6) f_(0xF7) \
+			f_(0xF8) f_(0xF9) f_(0xFA) f_(0xFB) f_(0xFC) f_(0xFD) f_(0xFE) f_(0xFF)
+
+		struct Cpu::HookNone
+		{
+			void operator () (uint) const {}
+		};
+
+		struct Cpu::HookOne
+		{
+			const Hook hook;
+
+			explicit HookOne(const Hook& h)
+			: hook(h) {}
+
+			void operator () (uint) const
+			{
+				hook.Execute();
+			}
+		};
+
+		struct Cpu::HookAll
+		{
+			const Hook* const first;
+			const Hook* const last;
+
+			HookAll(const Hook* f,uint n)
+			: first(f), last(f + (n - 1)) {}
+
+			void operator () (uint) const
+			{
+				const Hook* NST_RESTRICT hook = first;
+
+				hook->Execute();
+
+				do
+				{
+					(++hook)->Execute();
+				}
+				while (hook != last);
+			}
+		};
+
+		struct Cpu::HookIdle
+		{
+			Cpu& cpu;
+
+			explicit HookIdle(Cpu& c)
+			: cpu(c) {}
+
+			void operator () (const uint op) const
+			{
+				if ((op & 0x1F) == 0x10 || op == 0x4C)
+					cpu.IdleLoop();
+			}
+		};
+
+		template<typename T>
+		NST_FORCE_INLINE void Cpu::Run(const T& hook)
+		{
+			do
+			{
+			#ifdef NST_COMPUTED_GOTO
+
+				#define NES_LABEL(hex_) &&op_##hex_,
+
+				static const void* const labels[0x100] =
+				{
+					NES_OPCODES(NES_LABEL)
+				};
+
+				#undef NES_LABEL
+
+				cycles.offset = cycles.count;
+				goto *labels[opcode=FetchPc8()];
+
+				#define NES_OP(hex_)                                     \
+                                                                         \
+				op_##hex_:                                               \
+                                                                         \
+					op##hex_();                                          \
+					hook( hex_ );                                        \
+                                                                         \
+					if (cycles.count < cycles.round)                     \
+					{                                                    \
+						cycles.offset = cycles.count;                    \
+						goto *labels[opcode=FetchPc8()];                 \
+					}                                                    \
+                                                                         \
+					goto done;
+
+				NES_OPCODES(NES_OP)
+
+				#undef NES_OP
+
+			done:
+
+			#else
+
+				do
+				{
+					cycles.offset = cycles.count;
+
+					#define NES_OP(hex_) case hex_: op##hex_(); break;
+
+					switch (opcode=FetchPc8())
+					{
+						NES_OPCODES(NES_OP)
+					}
+
+					#undef NES_OP
+
+					hook( opcode );
+				}
+				while (cycles.count < cycles.round);
+
+			#endif
+
+				Clock();
+			}
+			while (cycles.count < cycles.frame);
+		}
+
+		void Cpu::Run0()
+		{
+			if (idle.enabled)
+				Run( HookIdle(*this) );
+			else
+				Run( HookNone() );
+		}
+
+		void Cpu::Run1()
+		{
+			Run( HookOne(*hooks.Ptr()) );
+		}
+
+		void Cpu::Run2()
+		{
+			Run( HookAll(hooks.Ptr(),hooks.Size()) );
+		}
+
+		#undef NES_OPCODES
+
+	#endif
+
 		#undef StoreZpgX
 		#undef StoreZpgY
 		#undef StoreAbs
@@ -28,6 +28,7 @@
 #include "NstAssert.hpp"
 #include "NstIoMap.hpp"
 #include "NstApu.hpp"
+#include "api/NstApi.hpp"
 
 #ifdef NST_PRAGMA_ONCE
 #pragma once
@@ -94,7 +95,7 @@ namespace Nes
 
 		private:
 
-			static void NotifyOp(const char (&)[4],dword);
+			void NotifyOp(const char (&)[4],dword);
 
 			enum
 			{
@@ -131,6 +132,20 @@ namespace Nes
 			void Run0();
 			void Run1();
 			void Run2();
+			void IdleLoop();
+			bool ScanIdleLoop(uint) const;
+
+		#ifndef NST_NO_THREADED_CPU
+
+			struct HookNone;
+			struct HookOne;
+			struct HookAll;
+			struct HookIdle;
+
+			template<typename T>
+			NST_FORCE_INLINE void Run(const T&);
+
+		#endif
 
 			inline void ExecuteOp();
 			inline uint FetchPc8();
@@ -395,6 +410,29 @@ namespace Nes
 				uint low;
 			};
 
+			struct Idle
+			{
+				Idle();
+
+				void Reset();
+
+				enum
+				{
+					MAX_LOOP_SIZE = 16
+				};
+
+				ibool enabled;
+				ibool loop;
+				uint head;
+				Cycle count;
+				uint a;
+				uint x;
+				uint y;
+				uint nz;
+				uint c;
+				uint v;
+			};
+
 			class Hooks
 			{
 			public:
@@ -443,6 +481,33 @@ namespace Nes
 				inline uint Peek8(uint) const;
 				inline uint Peek16(uint) const;
 				inline void Poke8(uint,uint) const;
+
+				void Reset();
+				bool IsDirect(uint) const;
+				void Invalidate(Address,Address);
+				void SetDirect(Address,Address,const byte* const*,uint);
+				void Update();
+
+				enum
+				{
+					DIRECT_SHIFT = 10,
+					DIRECT_PAGES = SIZE >> DIRECT_SHIFT
+				};
+
+				struct Page
+				{
+					const byte* const* bank;
+					uint mask;
+				};
+
+				struct Source : Page
+				{
+					Io::Port port;
+				};
+
+				Page pages[DIRECT_PAGES+1];
+				Source sources[DIRECT_PAGES];
+				bool dirty;
 			};
 
 			class Linker
@@ -476,6 +541,7 @@ namespace Nes
 			uint sp;
 			Flags flags;
 			Interrupt interrupt;
+			Idle idle;
 			Hooks hooks;
 			uint opcode;
 			word jammed;
@@ -483,10 +549,12 @@ namespace Nes
 			Linker linker;
 			qaword ticks;
 			Ram ram;
+			const byte* const ramBank;
 			Apu apu;
 			IoMap map;
+			dword logged;
+			UserCallbacks callbacks;
 
-			static dword logged;
 			static void (Cpu::*const opcodes[0x100])();
 			static const byte writeClocks[0x100];
 
@@ -497,6 +565,16 @@ namespace Nes
 				return apu;
 			}
 
+			UserCallbacks& GetCallbacks()
+			{
+				return callbacks;
+			}
+
+			const UserCallbacks& GetCallbacks() const
+			{
+				return callbacks;
+			}
+
 			Cycle Update(uint readAddress=0)
 			{
 				apu.ClockDMA( readAddress );
@@ -572,14 +650,31 @@ namespace Nes
 
 			Io::Port& Map(Address address)
 			{
+				map.Invalidate( address, address );
 				return map( address );
 			}
 
 			IoMap::Section Map(Address first,Address last)
 			{
+				map.Invalidate( first, last );
 				return map( first, last );
 			}
 
+			void MapDirect(Address first,Address last,const byte* const* bank,uint mask)
+			{
+				map.SetDirect( first, last, bank, mask );
+			}
+
+			void EnableIdleSkip(bool enable)
+			{
+				idle.enabled = enable;
+			}
+
+			bool HasIdleSkip() const
+			{
+				return idle.enabled;
+			}
+
 			template<typename T,typename U,typename V>
 			const Io::Port* Link(Address address,Level level,T t,U u,V v)
 			{
@@ -83,7 +83,7 @@ namespace Nes
 			{
 			}
 
-			void Set(std::istream* const stdStream)
+			void Set(std::istream* const stdStream,const UserCallbacks& callbacks)
 			{
 				available = false;
 
@@ -92,19 +92,19 @@ namespace Nes
 					Stream::In(stdStream).Read( rom, SIZE_8K );
 					available = true;
 
-					if (Log::Available())
+					if (Log::Available( callbacks ))
 					{
 						switch (Crc32::Compute( rom, SIZE_8K ))
 						{
 							case FAMICOM_ID:
 							case TWINSYSTEM_ID:
 
-								Log::Flush( "Fds: BIOS ROM ok" NST_LINEBREAK );
+								Log::Flush( callbacks, "Fds: BIOS ROM ok" NST_LINEBREAK );
 								break;
 
 							default:
 
-								Log::Flush( "Fds: warning, unknown BIOS ROM!" NST_LINEBREAK );
+								Log::Flush( callbacks, "Fds: warning, unknown BIOS ROM!" NST_LINEBREAK );
 								break;
 						}
 					}
@@ -163,7 +163,7 @@ namespace Nes
 		Fds::Fds(Context& context)
 		:
 		Image   (DISK),
-		disks   (context.stream),
+		disks   (context.stream,context.cpu.GetCallbacks()),
 		adapter (context.cpu,disks.sides),
 		cpu     (context.cpu),
 		ppu     (context.ppu),
@@ -232,15 +232,15 @@ namespace Nes
 			if (io.led != Api::Fds::MOTOR_OFF)
 			{
 				io.led = Api::Fds::MOTOR_OFF;
-				Api::Fds::driveCallback( Api::Fds::MOTOR_OFF );
+				cpu.GetCallbacks()[Api::Fds::driveCallback]( Api::Fds::MOTOR_OFF );
 			}
 
 			return true;
 		}
 
-		void Fds::SetBios(std::istream* stream)
+		void Fds::SetBios(std::istream* stream,const UserCallbacks& callbacks)
 		{
-			bios.Set( stream );
+			bios.Set( stream, callbacks );
 		}
 
 		Result Fds::GetBios(std::ostream& stream)
@@ -309,9 +309,9 @@ namespace Nes
 						adapter.Mount( NULL );
 
 						if (prev != Disks::EJECTED)
-							Api::Fds::diskCallback( Api::Fds::DISK_EJECT, prev / 2, prev % 2 );
+							cpu.GetCallbacks()[Api::Fds::diskCallback]( Api::Fds::DISK_EJECT, prev / 2, prev % 2 );
 
-						Api::Fds::diskCallback( Api::Fds::DISK_INSERT, disk / 2, disk % 2 );
+						cpu.GetCallbacks()[Api::Fds::diskCallback]( Api::Fds::DISK_INSERT, disk / 2, disk % 2 );
 
 						return RESULT_OK;
 					}
@@ -334,7 +334,7 @@ namespace Nes
 
 				adapter.Mount( NULL );
 
-				Api::Fds::diskCallback( Api::Fds::DISK_EJECT, prev / 2, prev % 2 );
+				cpu.GetCallbacks()[Api::Fds::diskCallback]( Api::Fds::DISK_EJECT, prev / 2, prev % 2 );
 
 				return RESULT_OK;
 			}
@@ -627,7 +627,8 @@ namespace Nes
 		#pragma optimize("s", on)
 		#endif
 
-		Fds::Disks::Sides::Sides(std::istream& stdStream)
+		Fds::Disks::Sides::Sides(std::istream& stdStream,const UserCallbacks& callbacks)
+		: file(callbacks)
 		{
 			Stream::In stream( &stdStream );
 
@@ -698,18 +699,18 @@ namespace Nes
 			}
 		}
 
-		Fds::Disks::Disks(std::istream& stream)
+		Fds::Disks::Disks(std::istream& stream,const UserCallbacks& callbacks)
 		:
-		sides          (stream),
+		sides          (stream,callbacks),
 		crc            (Crc32::Compute( sides[0], sides.count * dword(SIDE_SIZE) )),
 		id             (dword(sides[0][0x0F]) << 24 | dword(sides[0][0x10]) << 16 | uint(sides[0][0x11]) <<  8 | sides[0][0x12]),
 		current        (EJECTED),
 		mounting       (0),
 		writeProtected (false)
 		{
-			if (Log::Available())
+			if (Log::Available( callbacks ))
 			{
-				Log log;
+				Log log( callbacks );
 
 				for (uint i=0; i < sides.count; ++i)
 				{
@@ -1416,7 +1417,7 @@ namespace Nes
 				if (io.led != led && (io.led != Api::Fds::MOTOR_WRITE || led != Api::Fds::MOTOR_READ))
 				{
 					io.led = led;
-					Api::Fds::driveCallback( static_cast<Api::Fds::Motor>(io.led) );
+					cpu.GetCallbacks()[Api::Fds::driveCallback]( static_cast<Api::Fds::Motor>(io.led) );
 				}
 			}
 			else if (!--disks.mounting)
@@ -1477,7 +1478,7 @@ namespace Nes
 			{
 				disks.writeProtected = true;
 				adapter.WriteProtect();
-				Api::Fds::diskCallback( Api::Fds::DISK_NONSTANDARD, disks.current / 2, disks.current % 2 );
+				cpu.GetCallbacks()[Api::Fds::diskCallback]( Api::Fds::DISK_NONSTANDARD, disks.current / 2, disks.current % 2 );
 			}
 
 			return data & 0xFF;
@@ -51,7 +51,7 @@ namespace Nes
 			Result EjectDisk();
 			Result GetDiskData(uint,Api::Fds::DiskData&) const;
 
-			static void SetBios(std::istream*);
+			static void SetBios(std::istream*,const UserCallbacks&);
 			static Result GetBios(std::ostream&);
 			static bool HasBios();
 
@@ -266,7 +266,7 @@ namespace Nes
 
 			struct Disks
 			{
-				explicit Disks(std::istream&);
+				Disks(std::istream&,const UserCallbacks&);
 
 				enum
 				{
@@ -278,7 +278,7 @@ namespace Nes
 				{
 				public:
 
-					explicit Sides(std::istream&);
+					Sides(std::istream&,const UserCallbacks&);
 					~Sides();
 
 					inline byte* operator [] (uint) const;
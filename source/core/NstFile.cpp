@@ -42,8 +42,10 @@ namespace Nes
 			Vector<byte> data;
 		};
 
-		File::File()
-		: context( *new Context )
+		File::File(const UserCallbacks& c)
+		:
+		context   ( *new Context ),
+		callbacks ( c )
 		{
 		}
 
@@ -250,7 +252,7 @@ namespace Nes
 
 			{
 				Loader loader( type, loadBlock, loadBlockCount, altered );
-				Api::User::fileIoCallback( loader );
+				callbacks[Api::User::fileIoCallback]( loader );
 			}
 
 			context.checksum.Clear();
@@ -360,7 +362,7 @@ namespace Nes
 
 			{
 				Loader loader( type, buffer, maxsize );
-				Api::User::fileIoCallback( loader );
+				callbacks[Api::User::fileIoCallback]( loader );
 			}
 
 			if (buffer.Size())
@@ -525,7 +527,7 @@ namespace Nes
 				};
 
 				Saver saver( type, saveBlock, saveBlockCount, context.data );
-				Api::User::fileIoCallback( saver );
+				callbacks[Api::User::fileIoCallback]( saver );
 			}
 		}
 	}
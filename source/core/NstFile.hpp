@@ -25,6 +25,8 @@
 #ifndef NST_FILE_H
 #define NST_FILE_H
 
+#include "api/NstApi.hpp"
+
 #ifdef NST_PRAGMA_ONCE
 #pragma once
 #endif
@@ -40,10 +42,11 @@ namespace Nes
 		{
 			struct Context;
 			Context& context;
+			const UserCallbacks& callbacks;
 
 		public:
 
-			File();
+			explicit File(const UserCallbacks&);
 			~File();
 
 			enum Type
@@ -115,6 +115,11 @@ namespace Nes
 				return NULL;
 			}
 
+			virtual Image* Clone(Cpu&,Apu&,Ppu&) const
+			{
+				return NULL;
+			}
+
 		protected:
 
 			explicit Image(Type);
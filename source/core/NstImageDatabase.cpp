@@ -1000,7 +1000,8 @@ namespace Nes
 		};
 
 		ImageDatabase::ImageDatabase()
-		: enabled(true)
+		:
+		references (1)
 		{
 			items.begin = NULL;
 			items.end = NULL;
@@ -1175,7 +1176,7 @@ namespace Nes
 				item->Fill( profile, full );
 		}
 
-		Result ImageDatabase::Load(std::istream& baseStream,std::istream* overrideStream)
+		Result ImageDatabase::Load(std::istream& baseStream,std::istream* overrideStream,const UserCallbacks& callbacks)
 		{
 			Unload();
 
@@ -1590,21 +1591,21 @@ namespace Nes
 			}
 			catch (Result result)
 			{
-				Unload( true );
+				Unload( &callbacks );
 				return result;
 			}
 			catch (const std::bad_alloc&)
 			{
-				Unload( true );
+				Unload( &callbacks );
 				return RESULT_ERR_OUT_OF_MEMORY;
 			}
 			catch (...)
 			{
-				Unload( true );
+				Unload( &callbacks );
 				return RESULT_ERR_GENERIC;
 			}
 
-			Log() << "Database: "
+			Log( callbacks ) << "Database: "
                   << (items.end - items.begin)
                   << " items imported from "
                   << (overrideStream ? "internal & external" : "internal")
@@ -1613,7 +1614,7 @@ namespace Nes
 			return RESULT_OK;
 		}
 
-		void ImageDatabase::Unload(const bool error)
+		void ImageDatabase::Unload(const UserCallbacks* const error)
 		{
 			if (const Item** it=items.begin)
 			{
@@ -1634,7 +1635,7 @@ namespace Nes
 			strings.Destroy();
 
 			if (error)
-				Log::Flush( "Database: error, aborting.." NST_LINEBREAK );
+				Log::Flush( *error, "Database: error, aborting.." NST_LINEBREAK );
 		}
 
 		ImageDatabase::Item::Builder::~Builder()
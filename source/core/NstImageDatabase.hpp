@@ -103,8 +103,8 @@ namespace Nes
 
 		private:
 
-			Result Load(std::istream&,std::istream*);
-			void Unload(bool);
+			Result Load(std::istream&,std::istream*,const UserCallbacks&);
+			void Unload(const UserCallbacks*);
 
 			typedef Vector<wchar_t> Strings;
 
@@ -122,7 +122,7 @@ namespace Nes
 				HASHING_CRC    = 0x2
 			};
 
-			ibool enabled;
+			uint references;
 
 			struct
 			{
@@ -135,29 +135,38 @@ namespace Nes
 
 		public:
 
-			Result Load(std::istream& stream)
+			Result Load(std::istream& stream,const UserCallbacks& callbacks)
 			{
-				return Load( stream, NULL );
+				return Load( stream, NULL, callbacks );
 			}
 
-			Result Load(std::istream& baseStream,std::istream& overrideStream)
+			Result Load(std::istream& baseStream,std::istream& overrideStream,const UserCallbacks& callbacks)
 			{
-				return Load( baseStream, &overrideStream );
+				return Load( baseStream, &overrideStream, callbacks );
 			}
 
 			void Unload()
 			{
-				Unload( false );
+				Unload( NULL );
 			}
 
-			void Enable(bool state=true)
+			bool Shared() const
 			{
-				enabled = state;
+				return references > 1;
 			}
 
-			bool Enabled() const
+			// not atomic, callers serialize attaching and releasing
+
+			ImageDatabase* Attach()
+			{
+				++references;
+				return this;
+			}
+
+			void Release()
 			{
-				return enabled;
+				if (!--references)
+					delete this;
 			}
 		};
 	}
@@ -39,30 +39,35 @@ namespace Nes
 
 		struct Log::Object
 		{
+			Api::User::LogCallback function;
+			Api::User::UserData userdata;
 			std::string string;
 		};
 
-		bool Log::enabled = true;
-
-		Log::Log()
-		: object( !Api::User::logCallback ? NULL : new (std::nothrow) Object )
+		Log::Log(const UserCallbacks& callbacks)
+		: object( !Available(callbacks) ? NULL : new (std::nothrow) Object )
 		{
+			if (object)
+				callbacks[Api::User::logCallback].Get( object->function, object->userdata );
 		}
 
 		Log::~Log()
 		{
 			if (object)
 			{
-				if (enabled)
-					Api::User::logCallback( object->string.c_str(), object->string.size() );
-
+				object->function( object->userdata, object->string.c_str(), object->string.size() );
 				delete object;
 			}
 		}
 
-		bool Log::Available()
+		Log::Suppressor::Suppressor()
 		{
-			return Api::User::logCallback;
+			Set( Api::User::logCallback, NULL, NULL );
+		}
+
+		bool Log::Available(const UserCallbacks& callbacks)
+		{
+			return callbacks[Api::User::logCallback];
 		}
 
 		void Log::Append(cstring c,ulong n)
@@ -72,7 +77,7 @@ namespace Nes
 
 		Log& Log::operator << (long value)
 		{
-			if (enabled && object)
+			if (object)
 			{
 				char buffer[24];
 
@@ -88,7 +93,7 @@ namespace Nes
 
 		Log& Log::operator << (ulong value)
 		{
-			if (enabled && object)
+			if (object)
 			{
 				char buffer[24];
 
@@ -104,7 +109,7 @@ namespace Nes
 
 		Log& Log::operator << (long long value)
 		{
-			if (enabled && object)
+			if (object)
 			{
 				char buffer[24];
 
@@ -126,7 +131,7 @@ namespace Nes
 
 		Log& Log::operator << (unsigned long long value)
 		{
-			if (enabled && object)
+			if (object)
 			{
 				char buffer[24];
 
@@ -148,7 +153,7 @@ namespace Nes
 
 		Log& Log::operator << (cstring c)
 		{
-			if (enabled && object)
+			if (object)
 				object->string.append( c );
 
 			return *this;
@@ -156,7 +161,7 @@ namespace Nes
 
 		Log& Log::operator << (char c)
 		{
-			if (enabled && object)
+			if (object)
 				object->string.append( 1, c );
 
 			return *this;
@@ -164,7 +169,7 @@ namespace Nes
 
 		Log& Log::operator << (const Hex& hex)
 		{
-			if (enabled && object)
+			if (object)
 			{
 				char buffer[16];
 
@@ -181,10 +186,9 @@ namespace Nes
 			return *this;
 		}
 
-		void Log::Flush(cstring string,dword length)
+		void Log::Flush(const UserCallbacks& callbacks,cstring string,dword length)
 		{
-			if (enabled)
-				Api::User::logCallback( string, length );
+			callbacks[Api::User::logCallback]( string, length );
 		}
 
 		#ifdef NST_MSVC_OPTIMIZE
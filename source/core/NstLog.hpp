@@ -29,6 +29,8 @@
 #include "NstCore.hpp"
 #endif
 
+#include "api/NstApi.hpp"
+
 #ifdef NST_PRAGMA_ONCE
 #pragma once
 #endif
@@ -49,7 +51,7 @@ namespace Nes
 		{
 		public:
 
-			Log();
+			explicit Log(const UserCallbacks&);
 			~Log();
 
 			struct Hex
@@ -72,8 +74,8 @@ namespace Nes
 			Log& operator << (long long);
 			Log& operator << (unsigned long long);
 
-			static void Flush(cstring,dword);
-			static bool Available();
+			static void Flush(const UserCallbacks&,cstring,dword);
+			static bool Available(const UserCallbacks&);
 
 		private:
 
@@ -82,8 +84,6 @@ namespace Nes
 			struct Object;
 			Object* const object;
 
-			static bool enabled;
-
 		public:
 
 			Log& operator << (schar  i) { return operator << ( long  (i) ); }
@@ -93,29 +93,18 @@ namespace Nes
 			Log& operator << (int    i) { return operator << ( long  (i) ); }
 			Log& operator << (uint   i) { return operator << ( ulong (i) ); }
 
-			class Suppressor
+			class Suppressor : public UserCallbacks
 			{
-				const bool state;
-
 			public:
 
-				Suppressor()
-				: state(enabled)
-				{
-					enabled = false;
-				}
-
-				~Suppressor()
-				{
-					enabled = state;
-				}
+				Suppressor();
 			};
 
 			template<dword N>
-			static void Flush(const char (&c)[N])
+			static void Flush(const UserCallbacks& callbacks,const char (&c)[N])
 			{
 				NST_COMPILE_ASSERT( N > 0 );
-				Flush( c, N-1 );
+				Flush( callbacks, c, N-1 );
 			}
 		};
 	}
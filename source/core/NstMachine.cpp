@@ -43,14 +43,15 @@ namespace Nes
 
 		Machine::Machine()
 		:
-		state         (Api::Machine::NTSC),
-		frame         (0),
-		extPort       (new Input::AdapterTwo( *new Input::Pad(cpu,0), *new Input::Pad(cpu,1) )),
-		expPort       (new Input::Device( cpu )),
-		image         (NULL),
-		cheats        (NULL),
-		imageDatabase (NULL),
-		ppu           (cpu)
+		state                (Api::Machine::NTSC),
+		frame                (0),
+		extPort              (new Input::AdapterTwo( *new Input::Pad(cpu,0), *new Input::Pad(cpu,1) )),
+		expPort              (new Input::Device( cpu )),
+		image                (NULL),
+		cheats               (NULL),
+		imageDatabase        (NULL),
+		imageDatabaseEnabled (true),
+		ppu                  (cpu)
 		{
 		}
 
@@ -58,7 +59,9 @@ namespace Nes
 		{
 			Unload();
 
-			delete imageDatabase;
+			if (imageDatabase)
+				imageDatabase->Release();
+
 			delete cheats;
 			delete expPort;
 
@@ -93,7 +96,7 @@ namespace Nes
 				patchResult,
 				system,
 				ask,
-				imageDatabase
+				imageDatabaseEnabled ? imageDatabase : NULL
 			);
 
 			image = Image::Load( context );
@@ -131,7 +134,7 @@ namespace Nes
 
 			UpdateModels();
 
-			Api::Machine::eventCallback( Api::Machine::EVENT_LOAD, context.result );
+			cpu.GetCallbacks()[Api::Machine::eventCallback]( Api::Machine::EVENT_LOAD, context.result );
 
 			return context.result;
 		}
@@ -150,11 +153,52 @@ namespace Nes
 
 			state &= (Api::Machine::NTSC|Api::Machine::PAL);
 
-			Api::Machine::eventCallback( Api::Machine::EVENT_UNLOAD, result );
+			cpu.GetCallbacks()[Api::Machine::eventCallback]( Api::Machine::EVENT_UNLOAD, result );
 
 			return result;
 		}
 
+		Result Machine::Clone(Machine& target) const
+		{
+			NST_ASSERT( &target != this );
+
+			if (!Is(Api::Machine::GAME,Api::Machine::ON))
+				return RESULT_ERR_NOT_READY;
+
+			target.Unload();
+
+			if ((target.state ^ state) & Api::Machine::NTSC)
+				target.SwitchMode();
+
+			target.image = image->Clone( target.cpu, target.cpu.GetApu(), target.ppu );
+
+			if (!target.image)
+				return RESULT_ERR_UNSUPPORTED;
+
+			target.state |= state & (Api::Machine::IMAGE|Api::Machine::VS|Api::Machine::PC10);
+			target.ppu.EnableSpriteLimit( ppu.HasSpriteLimit() );
+			target.UpdateModels();
+
+			target.cpu.GetCallbacks()[Api::Machine::eventCallback]( Api::Machine::EVENT_LOAD, RESULT_OK );
+
+			target.Reset( true );
+
+			State::Saver counter( static_cast<byte*>(NULL), 0, true );
+			SaveState( counter );
+
+			Vector<byte> buffer( counter.Size() );
+
+			{
+				State::Saver saver( buffer.Begin(), buffer.Size(), true );
+				SaveState( saver );
+			}
+
+			State::Loader loader( buffer.Begin(), buffer.Size(), false );
+			target.LoadState( loader, false );
+
+			return RESULT_OK;
+		}
+
 		void Machine::UpdateModels()
 		{
 			const Region region = (state & Api::Machine::NTSC) ? REGION_NTSC : REGION_PAL;
@@ -247,7 +291,7 @@ namespace Nes
 				state &= ~uint(Api::Machine::ON);
 				frame = 0;
 
-				Api::Machine::eventCallback( Api::Machine::EVENT_POWER_OFF, result );
+				cpu.GetCallbacks()[Api::Machine::eventCallback]( Api::Machine::EVENT_POWER_OFF, result );
 			}
 
 			return result;
@@ -306,12 +350,12 @@ namespace Nes
 
 				if (state & Api::Machine::ON)
 				{
-					Api::Machine::eventCallback( hard ? Api::Machine::EVENT_RESET_HARD : Api::Machine::EVENT_RESET_SOFT );
+					cpu.GetCallbacks()[Api::Machine::eventCallback]( hard ? Api::Machine::EVENT_RESET_HARD : Api::Machine::EVENT_RESET_SOFT );
 				}
 				else
 				{
 					state |= Api::Machine::ON;
-					Api::Machine::eventCallback( Api::Machine::EVENT_POWER_ON );
+					cpu.GetCallbacks()[Api::Machine::eventCallback]( Api::Machine::EVENT_POWER_ON );
 				}
 			}
 			catch (...)
@@ -332,7 +376,7 @@ namespace Nes
 
 			UpdateModels();
 
-			Api::Machine::eventCallback( (state & Api::Machine::NTSC) ? Api::Machine::EVENT_MODE_NTSC : Api::Machine::EVENT_MODE_PAL );
+			cpu.GetCallbacks()[Api::Machine::eventCallback]( (state & Api::Machine::NTSC) ? Api::Machine::EVENT_MODE_NTSC : Api::Machine::EVENT_MODE_PAL );
 		}
 
 		void Machine::InitializeInputDevices() const
@@ -399,7 +443,7 @@ namespace Nes
 							(
 								loader.CheckCrc() && !(state & Api::Machine::DISK) &&
 								crc && crc != image->GetPrgCrc() &&
-								Api::User::questionCallback( Api::User::QUESTION_NST_PRG_CRC_FAIL_CONTINUE ) == Api::User::ANSWER_NO
+								cpu.GetCallbacks()[Api::User::questionCallback]( Api::User::QUESTION_NST_PRG_CRC_FAIL_CONTINUE ) == Api::User::ANSWER_NO
 							)
 							{
 								for (uint i=0; i < 2; ++i)
@@ -485,14 +529,37 @@ namespace Nes
 		#pragma optimize("", on)
 		#endif
 
+		bool Machine::HasLightGun() const
+		{
+			for (uint i=0; i < extPort->NumPorts(); ++i)
+			{
+				if (extPort->GetDevice( i ).GetType() == Api::Input::ZAPPER)
+					return true;
+			}
+
+			return expPort->GetType() == Api::Input::BANDAIHYPERSHOT;
+		}
+
 		void Machine::Execute
 		(
 			Video::Output* const video,
 			Sound::Output* const sound,
 			Input::Controllers* const input
 		)
+		{
+			Execute( video, sound, input, video || !ppu.HasRenderSkip() || tracker.IsRewinding() );
+		}
+
+		void Machine::Execute
+		(
+			Video::Output* const video,
+			Sound::Output* const sound,
+			Input::Controllers* const input,
+			const bool render
+		)
 		{
 			NST_ASSERT( state & Api::Machine::ON );
+			NST_ASSERT( render || !video );
 
 			if (!(state & Api::Machine::SOUND))
 			{
@@ -502,7 +569,7 @@ namespace Nes
 				extPort->BeginFrame( input );
 				expPort->BeginFrame( input );
 
-				ppu.BeginFrame( tracker.IsFrameLocked() );
+				ppu.BeginFrame( tracker.IsFrameLocked(), render || HasLightGun() );
 
 				if (cheats)
 					cheats->BeginFrame( tracker.IsFrameLocked() );
@@ -512,8 +579,11 @@ namespace Nes
 				
 				renderer.bgColor = ppu.output.bgColor;
 
+				if (render)
+					renderer.UpdateFrameHash( ppu.GetScreen(), ppu.GetBurstPhase() );
+
 				if (video)
-					renderer.Blit( *video, ppu.GetScreen(), ppu.GetBurstPhase() );
+					renderer.Blit( *video, ppu.GetScreen(), ppu.GetBurstPhase(), cpu.GetCallbacks() );
 
 				cpu.EndFrame();
 
@@ -74,6 +74,14 @@ namespace Nes
 				Input::Controllers*
 			);
 
+			void Execute
+			(
+				Video::Output*,
+				Sound::Output*,
+				Input::Controllers*,
+				bool
+			);
+
 			enum ColorMode
 			{
 				COLORMODE_YUV,
@@ -93,6 +101,7 @@ namespace Nes
 			);
 
 			Result Unload();
+			Result Clone(Machine&) const;
 			Result PowerOff(Result=RESULT_OK);
 			void   Reset(bool);
 			void   SwitchMode();
@@ -105,6 +114,7 @@ namespace Nes
 		private:
 
 			void UpdateModels();
+			bool HasLightGun() const;
 			Result UpdateVideo(PpuModel,ColorMode);
 			ColorMode GetColorMode() const;
 
@@ -128,6 +138,7 @@ namespace Nes
 			Image* image;
 			Cheats* cheats;
 			ImageDatabase* imageDatabase;
+			bool imageDatabaseEnabled;
 			Tracker tracker;
 			Cpu cpu;
 			Ppu ppu;
@@ -325,9 +325,9 @@ namespace Nes
 			if (types & Api::Nsf::CHIP_ALL)
 				chips = new Chips (types,apu);
 
-			if (Log::Available())
+			if (Log::Available( cpu.GetCallbacks() ))
 			{
-				Log log;
+				Log log( cpu.GetCallbacks() );
 
 				log << "Nsf: version " << version;
 
@@ -559,7 +559,7 @@ namespace Nes
 						apu.ClearBuffers();
 					}
 
-					Api::Nsf::eventCallback( Api::Nsf::EVENT_SELECT_SONG );
+					cpu.GetCallbacks()[Api::Nsf::eventCallback]( Api::Nsf::EVENT_SELECT_SONG );
 
 					return RESULT_OK;
 				}
@@ -577,7 +577,7 @@ namespace Nes
 				routine.nmi = Routine::NMI;
 				routine.playing = true;
 
-				Api::Nsf::eventCallback( Api::Nsf::EVENT_PLAY_SONG );
+				cpu.GetCallbacks()[Api::Nsf::eventCallback]( Api::Nsf::EVENT_PLAY_SONG );
 
 				return RESULT_OK;
 			}
@@ -593,7 +593,7 @@ namespace Nes
 				routine.nmi = Routine::NMI;
 				apu.ClearBuffers();
 
-				Api::Nsf::eventCallback( Api::Nsf::EVENT_STOP_SONG );
+				cpu.GetCallbacks()[Api::Nsf::eventCallback]( Api::Nsf::EVENT_STOP_SONG );
 
 				return RESULT_OK;
 			}
@@ -86,7 +86,7 @@ namespace Nes
 		: limit(buffer + STD_LINE_SPRITES*4), spriteLimit(true) {}
 
 		Ppu::Output::Output(Video::Screen::Pixel* p)
-		: pixels(p) {}
+		: pixels(p), render(true), renderSkip(false) {}
 
 		Ppu::TileLut::TileLut()
 		{
@@ -484,7 +484,7 @@ namespace Nes
 			return cycles.one == PPU_RP2C02_CC ? clock / PPU_RP2C02_CC : (clock+PPU_RP2C07_CC-1) / PPU_RP2C07_CC;
 		}
 
-		void Ppu::BeginFrame(bool frameLock)
+		void Ppu::BeginFrame(bool frameLock,bool render)
 		{
 			NST_ASSERT
 			(
@@ -496,6 +496,7 @@ namespace Nes
 
 			oam.limit = oam.buffer + ((oam.spriteLimit || frameLock) ? Oam::STD_LINE_SPRITES*4 : Oam::MAX_LINE_SPRITES*4);
 			output.target = output.pixels;
+			output.render = render;
 
 			Cycle frame;
 
@@ -1102,7 +1103,7 @@ namespace Nes
 			address = (address & ((X_TILE|NAME_LOW) ^ 0x7FFFU)) | (latch & (X_TILE|NAME_LOW));
 		}
 
-		NST_SINGLE_CALL void Ppu::Scroll::ClockY()
+		NST_FORCE_INLINE void Ppu::Scroll::ClockY()
 		{
 			if ((address & Y_FINE) != (7U << 12))
 			{
@@ -1138,7 +1139,7 @@ namespace Nes
 			dst[7] = src[1][3];
 		}
 
-		NST_SINGLE_CALL void Ppu::LoadTiles()
+		NST_FORCE_INLINE void Ppu::LoadTiles()
 		{
 			const byte* const NST_RESTRICT src[] =
 			{
@@ -1290,6 +1291,74 @@ namespace Nes
 			oam.address = (oam.address + 4) & 0xFF;
 		}
 
+		NST_SINGLE_CALL void Ppu::EvaluateSpritesLine()
+		{
+			NST_ASSERT( oam.phase == &Ppu::EvaluateSpritesPhase1 );
+
+			uint steps = (256 - 64) / 2;
+
+			if (oam.address == 0)
+			{
+				uint index = 0;
+
+				for (const byte* NST_RESTRICT sprite=oam.ram; index < 64 && oam.buffered != oam.limit; ++index, sprite += 4)
+				{
+					if (uint(scanline) - sprite[0] >= oam.height)
+					{
+						if (!steps)
+							break;
+
+						steps -= 1;
+						oam.latch = sprite[0];
+					}
+					else
+					{
+						if (steps < 4)
+							break;
+
+						steps -= 4;
+						oam.latch = sprite[3];
+
+						oam.buffered[0] = sprite[0];
+						oam.buffered[1] = sprite[1];
+						oam.buffered[2] = sprite[2];
+						oam.buffered[3] = sprite[3];
+						oam.buffered += 4;
+
+						if (index == 0)
+							oam.spriteZeroInLine = true;
+					}
+				}
+
+				oam.index = index;
+
+				if (index != 64)
+				{
+					oam.address = index * 4;
+					oam.phase = (oam.buffered != oam.limit ? &Ppu::EvaluateSpritesPhase1 : &Ppu::EvaluateSpritesPhase5);
+				}
+				else
+				{
+					oam.address = 0;
+					oam.phase = &Ppu::EvaluateSpritesPhase9;
+				}
+			}
+
+			if (oam.phase == &Ppu::EvaluateSpritesPhase9)
+			{
+				if (steps)
+				{
+					oam.latch = oam.ram[(oam.address + (steps - 1) * 4) & 0xFF];
+					oam.address = (oam.address + steps * 4) & 0xFF;
+				}
+			}
+			else while (steps--)
+			{
+				oam.latch = oam.ram[oam.address];
+				(*this.*oam.phase)();
+			}
+		}
+
 		NST_FORCE_INLINE uint Ppu::OpenSprite() const
 		{
 			return (regs.ctrl[0] & (Regs::CTRL0_SP_OFFSET|Regs::CTRL0_SP8X16)) ? 0x1FF0 : 0x0FF0;
@@ -1375,6 +1444,20 @@ namespace Nes
 			uint clock;
 			uint pixel = tiles.pixels[((clock=cycles.hClock++) + scroll.xFine) & 15] & tiles.mask;
 
+			Video::Screen::Pixel* const NST_RESTRICT target = output.target++;
+
+			if (!output.render)
+			{
+				// only sprite 0 hit is observable, sprite 0 is always the first entry
+
+				const Oam::Output* const NST_RESTRICT sprite = oam.output;
+
+				if (sprite != oam.visible && (pixel & sprite->zero) && clock - sprite->x <= 7 && (sprite->pixels[clock - sprite->x] & oam.mask))
+					regs.status |= Regs::STATUS_SP_ZERO_HIT;
+
+				return;
+			}
+
 			for (const Oam::Output* NST_RESTRICT sprite=oam.output, *const end=oam.visible; sprite != end; ++sprite)
 			{
 				uint x = clock - sprite->x;
@@ -1396,13 +1479,18 @@ namespace Nes
 				}
 			}
 
-			Video::Screen::Pixel* const NST_RESTRICT target = output.target++;
 			*target = output.palette[pixel];
 		}
 
-		NST_SINGLE_CALL void Ppu::RenderPixel255()
+		NST_FORCE_INLINE void Ppu::RenderPixel255()
 		{
 			cycles.hClock = 256;
+
+			Video::Screen::Pixel* const NST_RESTRICT target = output.target++;
+
+			if (!output.render)
+				return;
+
 			uint pixel = tiles.pixels[(255 + scroll.xFine) & 15] & tiles.mask;
 
 			for (const Oam::Output* NST_RESTRICT sprite=oam.output, *const end=oam.visible; sprite != end; ++sprite)
@@ -1423,10 +1511,124 @@ namespace Nes
 				}
 			}
 
-			Video::Screen::Pixel* const NST_RESTRICT target = output.target++;
 			*target = output.palette[pixel];
 		}
 
+		NST_SINGLE_CALL bool Ppu::LoadSpriteLine()
+		{
+			if (oam.output == oam.visible)
+				return false;
+
+			std::memset( oam.line, 0, sizeof(oam.line) );
+
+			for (const Oam::Output* NST_RESTRICT sprite=oam.visible; sprite-- != oam.output; )
+			{
+				const uint flags = (sprite->behind ? Oam::LINE_BEHIND : 0) | (sprite->zero ? Oam::LINE_ZERO : 0);
+
+				for (uint i=0, n=NST_MIN(8,256-sprite->x); i < n; ++i)
+				{
+					if (const uint pixel = sprite->pixels[i])
+						oam.line[sprite->x + i] = (sprite->palette + pixel) | flags;
+				}
+			}
+
+			return true;
+		}
+
+		NST_FORCE_INLINE void Ppu::RenderPixels(uint clock,const uint end,const bool sprites)
+		{
+			Video::Screen::Pixel* NST_RESTRICT target = output.target;
+			output.target += end - clock;
+
+			do
+			{
+				uint pixel = tiles.pixels[(clock + scroll.xFine) & 15] & tiles.mask;
+
+				if (sprites)
+				{
+					if (const uint sprite = oam.line[clock] & oam.mask)
+					{
+						if ((sprite & Oam::LINE_ZERO) && (pixel & 0x3) && clock != 255)
+							regs.status |= Regs::STATUS_SP_ZERO_HIT;
+
+						if (!((sprite & Oam::LINE_BEHIND) && (pixel & 0x3)))
+							pixel = sprite & Oam::LINE_PIXEL;
+					}
+				}
+
+				*target++ = output.palette[pixel];
+			}
+			while (++clock != end);
+		}
+
+		NST_SINGLE_CALL void Ppu::RunHActive()
+		{
+			NST_ASSERT( cycles.hClock == 0 && cycles.count > 255 );
+
+			const bool sprites = output.render && LoadSpriteLine();
+
+			for (uint dot=0; dot < 256; dot += 8)
+			{
+				if (dot == 64)
+				{
+					NST_VERIFY( regs.oam == 0 );
+					oam.address = regs.oam & Oam::OFFSET_TO_0_1;
+					oam.phase = &Ppu::EvaluateSpritesPhase1;
+					oam.latch = 0xFF;
+
+					EvaluateSpritesLine();
+				}
+
+				cycles.hClock = dot + 0;
+				LoadTiles();
+				OpenName();
+				cycles.hClock = dot + 1;
+				FetchName();
+				cycles.hClock = dot + 2;
+				OpenAttribute();
+				cycles.hClock = dot + 3;
+				FetchAttribute();
+
+				if (dot == 248)
+					scroll.ClockY();
+
+				scroll.ClockX();
+				cycles.hClock = dot + 4;
+				OpenPattern( io.pattern | 0x0 );
+				cycles.hClock = dot + 5;
+				FetchBgPattern0();
+				cycles.hClock = dot + 6;
+				OpenPattern( io.pattern | 0x8 );
+				cycles.hClock = dot + 7;
+				FetchBgPattern1();
+
+				if (output.render)
+				{
+					if (sprites)
+						RenderPixels( dot, dot + 8, true );
+					else
+						RenderPixels( dot, dot + 8, false );
+				}
+				else
+				{
+					cycles.hClock = dot;
+
+					for (uint i=0; i < 7; ++i)
+						RenderPixel();
+
+					if (dot != 248)
+						RenderPixel();
+					else
+						RenderPixel255();
+				}
+
+				tiles.mask = tiles.show[0];
+				oam.mask = oam.show[0];
+			}
+
+			cycles.hClock = 256;
+		}
+
 		NST_NO_INLINE void Ppu::Run()
 		{
 			NST_VERIFY( cycles.count != cycles.hClock );
@@ -1436,6 +1638,18 @@ namespace Nes
 				switch (cycles.hClock)
 				{
 					case 0:
+					HActive0:
+
+						if (cycles.count > 255)
+						{
+							RunHActive();
+
+							if (cycles.count <= 256)
+								break;
+
+							goto HBlank;
+						}
+
 					case 8:
 					case 16:
 					case 24:
@@ -1787,6 +2001,7 @@ namespace Nes
 							break;
 
 					case 256:
+					HBlank:
 
 						OpenName();
 						oam.latch = 0xFF;
@@ -2099,7 +2314,7 @@ namespace Nes
 
 							cycles.count -= line;
 
-							goto HActive;
+							goto HActive0;
 						}
 						else
 						{
@@ -2669,12 +2884,25 @@ namespace Nes
 						byte* const NST_RESTRICT tile = tiles.pixels;
 						Video::Screen::Pixel* NST_RESTRICT target = output.target;
 
-						do
+						if (output.render)
+						{
+							do
+							{
+								tile[i++ & 15] = 0;
+								*target++ = pixel;
+							}
+							while (i != hClock);
+						}
+						else
 						{
-							tile[i++ & 15] = 0;
-							*target++ = pixel;
+							target += hClock - i;
+
+							do
+							{
+								tile[i++ & 15] = 0;
+							}
+							while (i != hClock);
 						}
-						while (i != hClock);
 
 						output.target = target;
 
@@ -51,7 +51,7 @@ namespace Nes
 
 			void Reset(bool,bool);
 			void PowerOff();
-			void BeginFrame(bool);
+			void BeginFrame(bool,bool=true);
 			void EndFrame();
 
 			enum
@@ -200,6 +200,7 @@ namespace Nes
 			void EvaluateSpritesPhase7();
 			void EvaluateSpritesPhase8();
 			void EvaluateSpritesPhase9();
+			NST_SINGLE_CALL void EvaluateSpritesLine();
 
 			void Reset(bool,bool,bool);
 			void Update(Cycle,uint=0);
@@ -211,9 +212,12 @@ namespace Nes
 			NST_FORCE_INLINE uint OpenSprite(const byte* NST_RESTRICT) const;
 			NST_FORCE_INLINE  void LoadSprite(uint,uint,const byte* NST_RESTRICT);
 			NST_SINGLE_CALL void PreLoadTiles();
-			NST_SINGLE_CALL void LoadTiles();
+			NST_FORCE_INLINE void LoadTiles();
 			NST_FORCE_INLINE void RenderPixel();
-			NST_SINGLE_CALL void RenderPixel255();
+			NST_FORCE_INLINE void RenderPixel255();
+			NST_SINGLE_CALL bool LoadSpriteLine();
+			NST_FORCE_INLINE void RenderPixels(uint,uint,bool);
+			NST_SINGLE_CALL void RunHActive();
 			NST_NO_INLINE void Run();
 
 			struct Regs
@@ -267,7 +271,7 @@ namespace Nes
 
 				NST_FORCE_INLINE void ClockX();
 				NST_SINGLE_CALL  void ResetX();
-				NST_SINGLE_CALL  void ClockY();
+				NST_FORCE_INLINE void ClockY();
 
 				uint address;
 				uint toggle;
@@ -312,6 +316,8 @@ namespace Nes
 				uint burstPhase;
 				word palette[Palette::SIZE];
 				uint bgColor;
+				bool render;
+				bool renderSkip;
 			};
 
 			struct Oam
@@ -334,6 +340,13 @@ namespace Nes
 					TILE_LSB         = 0x01
 				};
 
+				enum
+				{
+					LINE_PIXEL  = 0x1F,
+					LINE_BEHIND = 0x20,
+					LINE_ZERO   = 0x40
+				};
+
 				struct Output
 				{
 					byte x;
@@ -362,6 +375,7 @@ namespace Nes
 				byte buffer[MAX_LINE_SPRITES*4];
 
 				Output output[MAX_LINE_SPRITES];
+				byte line[256];
 			};
 
 			struct NameTable
@@ -541,6 +555,16 @@ namespace Nes
 			{
 				return oam.spriteLimit;
 			}
+
+			void EnableRenderSkip(bool enable)
+			{
+				output.renderSkip = enable;
+			}
+
+			bool HasRenderSkip() const
+			{
+				return output.renderSkip;
+			}
 		};
 	}
 }
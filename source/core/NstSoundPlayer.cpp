@@ -57,7 +57,7 @@ namespace Nes
 				delete [] slots;
 			}
 
-			Player* Player::Create(Apu& apu,const Chips& chips,wcstring const chip,Game game,uint maxSamples)
+			Player* Player::Create(Apu& apu,const UserCallbacks& callbacks,const Chips& chips,wcstring const chip,Game game,uint maxSamples)
 			{
 				if (!maxSamples)
 					return NULL;
@@ -195,7 +195,7 @@ namespace Nes
 
 							try
 							{
-								Api::User::fileIoCallback( loader );
+								callbacks[Api::User::fileIoCallback]( loader );
 							}
 							catch (...)
 							{
@@ -57,7 +57,7 @@ namespace Nes
 					GAME_AEROBICS_STUDIO          = 8U  << GAME_NUM_SAMPLES_SHIFT | 5
 				};
 
-				static Player* Create(Apu&,const Chips&,wcstring,Game,uint);
+				static Player* Create(Apu&,const UserCallbacks&,const Chips&,wcstring,Game,uint);
 				static void Destroy(Player*);
 
 			private:
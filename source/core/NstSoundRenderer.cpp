@@ -23,9 +23,14 @@
 ////////////////////////////////////////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <cmath>
 #include "NstCpu.hpp"
 #include "NstSoundRenderer.hpp"
 
+#ifdef NST_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace Nes
 {
 	namespace Core
@@ -58,9 +63,225 @@ namespace Nes
 					std::fill( output, output+SIZE, iword(0) );
 			}
 
+			StepBuffer::StepBuffer()
+			: buffer(new float [SIZE])
+			{
+				const double pi = 3.1415926535897932384626433832795;
+				const double cutoff = 0.45;
+
+				for (uint phase=0; phase < PHASES; ++phase)
+				{
+					double sum = 0;
+					double taps[WIDTH];
+
+					for (uint i=0; i < WIDTH; ++i)
+					{
+						const double x = double(i) - (WIDTH/2 - 1) - (phase + 0.5) / PHASES;
+						const double w = x / (WIDTH/2);
+
+						taps[i] = (x ? std::sin( 2 * pi * cutoff * x ) / (pi * x) : 2 * cutoff) * (0.42 + 0.5 * std::cos( pi * w ) + 0.08 * std::cos( 2 * pi * w ));
+						sum += taps[i];
+					}
+
+					for (uint i=0; i < WIDTH; ++i)
+						kernel[phase][i] = float(taps[i] / sum);
+				}
+
+				Reset();
+			}
+
+			StepBuffer::~StepBuffer()
+			{
+				delete [] buffer;
+			}
+
+			void StepBuffer::Reset()
+			{
+				pos = 0;
+				sum = 0;
+
+				std::fill( buffer, buffer+SIZE, 0.f );
+			}
+
+			Resampler::Resampler()
+			:
+			quality  (0),
+			taps     (0),
+			count    (0),
+			position (0),
+			step     (qaword(1) << 32),
+			inputRate(1),
+			input    (new float [SIZE]),
+			kernel   (new float [PHASES * MAX_TAPS])
+			{
+			}
+
+			Resampler::~Resampler()
+			{
+				delete [] kernel;
+				delete [] input;
+			}
+
+			void Resampler::Reset(const uint q,const dword in,const dword out)
+			{
+				NST_ASSERT( q <= MAX_QUALITY && in && out );
+
+				quality = q;
+				taps = q ? 4U << q : 0;
+				count = 0;
+				position = 0;
+				inputRate = in;
+
+				SetOutputRate( out );
+
+				if (!taps)
+					return;
+
+				const double pi = 3.1415926535897932384626433832795;
+				const double cutoff = 0.45 * (out < in ? double(out) / in : 1.0);
+
+				for (uint phase=0; phase < PHASES; ++phase)
+				{
+					float* const NST_RESTRICT dst = kernel + phase * taps;
+					double sum = 0;
+
+					for (uint i=0; i < taps; ++i)
+					{
+						const double x = double(i) - (taps/2 - 1) - double(phase) / PHASES;
+						const double w = x / (taps/2);
+
+						sum += dst[i] = float((x ? std::sin( 2 * pi * cutoff * x ) / (pi * x) : 2 * cutoff) * (0.42 + 0.5 * std::cos( pi * w ) + 0.08 * std::cos( 2 * pi * w )));
+					}
+
+					for (uint i=0; i < taps; ++i)
+						dst[i] = float(dst[i] / sum);
+				}
+			}
+
+			void Resampler::Clear()
+			{
+				count = 0;
+				position = 0;
+			}
+
+			void Resampler::SetOutputRate(const dword out)
+			{
+				NST_ASSERT( out );
+				step = (qaword(inputRate) << 32) / out;
+			}
+
+			void Resampler::Compact()
+			{
+				const uint consumed = NST_MIN(uint(position >> 32),count);
+				const uint base = consumed ? consumed : SIZE/2;
+
+				std::copy( input+base, input+count, input );
+				count -= base;
+
+				if (consumed)
+					position -= qaword(base) << 32;
+				else
+					position &= 0xFFFFFFFF;
+			}
+
 			#ifdef NST_MSVC_OPTIMIZE
 			#pragma optimize("", on)
 			#endif
+
+			void Resampler::operator << (const Buffer::Block& block)
+			{
+				for (uint i=0; i < block.length; ++i)
+				{
+					if (count == SIZE)
+						Compact();
+
+					input[count++] = block.data[(block.start + i) & Buffer::MASK];
+				}
+			}
+
+			Sample Resampler::Read()
+			{
+				NST_ASSERT( CanRead() );
+
+				const float* const NST_RESTRICT src = input + uint(position >> 32);
+				const float* const NST_RESTRICT k = kernel + (uint(position >> PHASE_SHIFT) & (PHASES-1)) * taps;
+
+				position += step;
+
+			#ifdef NST_SSE2
+
+				__m128 acc = _mm_setzero_ps();
+
+				for (uint i=0; i < taps; i += 4)
+					acc = _mm_add_ps( acc, _mm_mul_ps( _mm_loadu_ps(src+i), _mm_loadu_ps(k+i) ) );
+
+				acc = _mm_add_ps( acc, _mm_movehl_ps( acc, acc ) );
+				acc = _mm_add_ss( acc, _mm_shuffle_ps( acc, acc, 0x1 ) );
+
+				const float sum = _mm_cvtss_f32( acc );
+
+			#else
+
+				float sum = 0;
+
+				for (uint i=0; i < taps; ++i)
+					sum += src[i] * k[i];
+
+			#endif
+
+				return Clamp<-32767,32767>( idword(sum >= 0 ? sum + 0.5f : sum - 0.5f) );
+			}
+
+			void StepBuffer::Add(const dword offset,const dword rate,const idword delta)
+			{
+				NST_ASSERT( rate );
+
+				uint index = offset / rate;
+
+				if (pos + index + WIDTH > SIZE)
+				{
+					Compact();
+
+					// a step beyond the buffer still has to change the level,
+					// so it's put at the far end rather than dropped
+
+					NST_VERIFY( index + WIDTH <= SIZE );
+
+					if (index + WIDTH > SIZE)
+						index = SIZE - WIDTH;
+				}
+
+				const float* const NST_RESTRICT taps = kernel[qaword(offset % rate) * PHASES / rate];
+				float* const NST_RESTRICT dst = buffer + pos + index;
+
+			#ifdef NST_SSE2
+
+				const __m128 d = _mm_set1_ps( float(delta) );
+
+				for (uint i=0; i < WIDTH; i += 4)
+					_mm_storeu_ps( dst+i, _mm_add_ps( _mm_loadu_ps(dst+i), _mm_mul_ps( _mm_loadu_ps(taps+i), d ) ) );
+
+			#else
+
+				for (uint i=0; i < WIDTH; ++i)
+					dst[i] += taps[i] * delta;
+
+			#endif
+			}
+
+			void StepBuffer::Compact()
+			{
+				std::copy( buffer+pos, buffer+SIZE, buffer );
+				std::fill( buffer+SIZE-pos, buffer+SIZE, 0.f );
+				pos = 0;
+			}
+
+			void StepBuffer::Flush()
+			{
+				std::copy( buffer+pos, buffer+pos+WIDTH+1, buffer );
+				std::fill( buffer+WIDTH+1, buffer+pos+WIDTH+1, 0.f );
+				pos = 0;
+			}
 		}
 	}
 }
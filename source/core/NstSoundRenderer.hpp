@@ -110,6 +110,104 @@ namespace Nes
 				History history;
 			};
 
+			class StepBuffer
+			{
+			public:
+
+				StepBuffer();
+				~StepBuffer();
+
+				enum
+				{
+					WIDTH = 16,
+					PHASES = 64,
+					// one frame at 192kHz and 30fps is 6400 samples
+					SIZE = 0x2000
+				};
+
+				void Reset();
+				void Add(dword,dword,idword);
+				void Flush();
+
+				inline Sample Read();
+
+			private:
+
+				enum
+				{
+					LEAK = 12
+				};
+
+				void Compact();
+
+				uint pos;
+				double sum;
+				float* const NST_RESTRICT buffer;
+				float kernel[PHASES][WIDTH];
+			};
+
+			class Resampler
+			{
+			public:
+
+				Resampler();
+				~Resampler();
+
+				enum
+				{
+					MAX_QUALITY = 3,
+					MAX_TAPS = 32,
+					PHASES = 256,
+					SIZE = 0x4000
+				};
+
+				void Reset(uint,dword,dword);
+				void Clear();
+				void SetOutputRate(dword);
+				void operator << (const Buffer::Block&);
+				Sample Read();
+
+				inline void operator << (Sample);
+
+				template<typename T>
+				inline bool operator >> (T&);
+
+			private:
+
+				enum
+				{
+					PHASE_SHIFT = 24
+				};
+
+				void Compact();
+
+				uint quality;
+				uint taps;
+				uint count;
+				qaword position;
+				qaword step;
+				dword inputRate;
+				float* const NST_RESTRICT input;
+				float* const NST_RESTRICT kernel;
+
+			public:
+
+				uint GetQuality() const
+				{
+					return quality;
+				}
+
+				dword GetInputRate() const
+				{
+					return inputRate;
+				}
+
+				bool CanRead() const
+				{
+					return (position >> 32) + taps <= count;
+				}
+			};
+
 			template<>
 			class Buffer::Renderer<iword,0U> : public Buffer::BaseRenderer<iword>
 			{
@@ -49,6 +49,34 @@ namespace Nes
 				}
 			}
 
+			inline Sample StepBuffer::Read()
+			{
+				if (pos == SIZE-WIDTH-1)
+					Compact();
+
+				sum += buffer[pos++];
+				sum -= sum / (1UL << LEAK);
+
+				return Sample(sum >= 0 ? sum + 0.5 : sum - 0.5);
+			}
+
+			inline void Resampler::operator << (const Sample sample)
+			{
+				if (count == SIZE)
+					Compact();
+
+				input[count++] = float(sample);
+			}
+
+			template<typename T>
+			inline bool Resampler::operator >> (T& output)
+			{
+				while (output && CanRead())
+					output << Read();
+
+				return output;
+			}
+
 			inline Buffer::Block::Block(uint l)
 			: length(l) {}
 
@@ -22,6 +22,7 @@
 //
 ////////////////////////////////////////////////////////////////////////////////////////
 
+#include <cstring>
 #include "NstState.hpp"
 #include "NstZlib.hpp"
 
@@ -42,7 +43,14 @@ namespace Nes
 			#endif
 
 			Saver::Saver(StdStream p,bool c,bool i,dword append)
-			: stream(p), chunks(CHUNK_RESERVE), useCompression(c), internal(i)
+			:
+			stream         (p),
+			chunks         (CHUNK_RESERVE),
+			memory         (NULL),
+			capacity       (0),
+			position       (0),
+			useCompression (c),
+			internal       (i)
 			{
 				NST_COMPILE_ASSERT( CHUNK_RESERVE >= 2 );
 
@@ -57,6 +65,19 @@ namespace Nes
 				}
 			}
 
+			Saver::Saver(byte* m,dword c,bool i)
+			:
+			chunks         (CHUNK_RESERVE),
+			memory         (m),
+			capacity       (c),
+			position       (0),
+			useCompression (false),
+			internal       (i)
+			{
+				chunks.SetTo(1);
+				chunks.Front() = 0;
+			}
+
 			Saver::~Saver()
 			{
 				NST_VERIFY( chunks.Size() == 1 );
@@ -66,10 +87,33 @@ namespace Nes
 			#pragma optimize("", on)
 			#endif
 
+			void Saver::Put(const byte* const data,const dword length)
+			{
+				if (stream != NULL)
+				{
+					stream.Write( data, length );
+				}
+				else
+				{
+					if (memory && position + length <= capacity)
+						std::memcpy( memory + position, data, length );
+
+					position += length;
+				}
+			}
+
 			Saver& Saver::Begin(dword chunk)
 			{
-				stream.Write32( chunk );
-				stream.Write32( 0 );
+				const byte data[8] =
+				{
+					byte(chunk >>  0 & 0xFF),
+					byte(chunk >>  8 & 0xFF),
+					byte(chunk >> 16 & 0xFF),
+					byte(chunk >> 24 & 0xFF),
+					0,0,0,0
+				};
+
+				Put( data, 8 );
 				chunks.Append( 0 );
 
 				return *this;
@@ -82,45 +126,91 @@ namespace Nes
 				const dword written = chunks.Pop();
 				chunks.Back() += 4 + 4 + written;
 
-				stream.Seek( -idword(written + 4) );
-				stream.Write32( written );
-				stream.Seek( written );
+				if (stream != NULL)
+				{
+					stream.Seek( -idword(written + 4) );
+					stream.Write32( written );
+					stream.Seek( written );
+				}
+				else if (memory && position - written <= capacity)
+				{
+					byte* const length = memory + position - (written + 4);
+
+					length[0] = written >>  0 & 0xFF;
+					length[1] = written >>  8 & 0xFF;
+					length[2] = written >> 16 & 0xFF;
+					length[3] = written >> 24 & 0xFF;
+				}
 
 				return *this;
 			}
 
 			Saver& Saver::Write8(uint data)
 			{
+				NST_VERIFY( data <= 0xFF );
+
+				const byte d = data & 0xFF;
+
 				chunks.Back() += 1;
-				stream.Write8( data );
+				Put( &d, 1 );
 				return *this;
 			}
 
 			Saver& Saver::Write16(uint data)
 			{
+				NST_VERIFY( data <= 0xFFFF );
+
+				const byte d[2] =
+				{
+					byte(data >> 0 & 0xFF),
+					byte(data >> 8 & 0xFF)
+				};
+
 				chunks.Back() += 2;
-				stream.Write16( data );
+				Put( d, 2 );
 				return *this;
 			}
 
 			Saver& Saver::Write32(dword data)
 			{
+				NST_VERIFY( data <= 0xFFFFFFFF );
+
+				const byte d[4] =
+				{
+					byte(data >>  0 & 0xFF),
+					byte(data >>  8 & 0xFF),
+					byte(data >> 16 & 0xFF),
+					byte(data >> 24 & 0xFF)
+				};
+
 				chunks.Back() += 4;
-				stream.Write32( data );
+				Put( d, 4 );
 				return *this;
 			}
 
 			Saver& Saver::Write64(qaword data)
 			{
+				const byte d[8] =
+				{
+					byte(data >>  0 & 0xFF),
+					byte(data >>  8 & 0xFF),
+					byte(data >> 16 & 0xFF),
+					byte(data >> 24 & 0xFF),
+					byte(data >> 32 & 0xFF),
+					byte(data >> 40 & 0xFF),
+					byte(data >> 48 & 0xFF),
+					byte(data >> 56 & 0xFF)
+				};
+
 				chunks.Back() += 8;
-				stream.Write64( data );
+				Put( d, 8 );
 				return *this;
 			}
 
 			Saver& Saver::Write(const byte* data,dword length)
 			{
 				chunks.Back() += length;
-				stream.Write( data, length );
+				Put( data, length );
 				return *this;
 			}
 
@@ -141,9 +231,11 @@ namespace Nes
 					}
 				}
 
+				const byte mode = NO_COMPRESSION;
+
 				chunks.Back() += 1 + length;
-				stream.Write8( NO_COMPRESSION );
-				stream.Write( data, length );
+				Put( &mode, 1 );
+				Put( data, length );
 
 				return *this;
 			}
@@ -153,11 +245,30 @@ namespace Nes
 			#endif
 
 			Loader::Loader(StdStream p,bool c)
-			: stream(p), chunks(CHUNK_RESERVE), checkCrc(c)
+			:
+			stream   (p),
+			chunks   (CHUNK_RESERVE),
+			memory   (NULL),
+			capacity (0),
+			position (0),
+			checkCrc (c)
 			{
 				chunks.SetTo(0);
 			}
 
+			Loader::Loader(const byte* m,dword s,bool c)
+			:
+			chunks   (CHUNK_RESERVE),
+			memory   (m),
+			capacity (s),
+			position (0),
+			checkCrc (c)
+			{
+				NST_ASSERT( memory || !capacity );
+
+				chunks.SetTo(0);
+			}
+
 			Loader::~Loader()
 			{
 				NST_VERIFY( chunks.Size() <= 1 );
@@ -167,13 +278,49 @@ namespace Nes
 			#pragma optimize("", on)
 			#endif
 
+			void Loader::Get(byte* const data,const dword length)
+			{
+				if (stream != NULL)
+				{
+					stream.Read( data, length );
+				}
+				else if (capacity - position >= length)
+				{
+					std::memcpy( data, memory + position, length );
+					position += length;
+				}
+				else
+				{
+					throw RESULT_ERR_CORRUPT_FILE;
+				}
+			}
+
+			void Loader::Seek(const idword distance)
+			{
+				if (stream != NULL)
+				{
+					stream.Seek( distance );
+				}
+				else if (distance >= 0 ? capacity - position >= dword(distance) : position >= dword(-distance))
+				{
+					position += distance;
+				}
+				else
+				{
+					throw RESULT_ERR_CORRUPT_FILE;
+				}
+			}
+
 			dword Loader::Begin()
 			{
 				if (chunks.Size() && !chunks.Back())
 					return 0;
 
-				const dword chunk = stream.Read32();
-				const dword length = stream.Read32();
+				byte data[8];
+				Get( data, 8 );
+
+				const dword chunk = data[0] | uint(data[1]) << 8 | dword(data[2]) << 16 | dword(data[3]) << 24;
+				const dword length = data[4] | uint(data[5]) << 8 | dword(data[6]) << 16 | dword(data[7]) << 24;
 
 				if (chunks.Size())
 				{
@@ -195,7 +342,14 @@ namespace Nes
 
 			dword Loader::Check()
 			{
-				return chunks.Size() && !chunks.Back() ? 0 : stream.Peek32();
+				if (chunks.Size() && !chunks.Back())
+					return 0;
+
+				byte data[4];
+				Get( data, 4 );
+				Seek( -4 );
+
+				return data[0] | uint(data[1]) << 8 | dword(data[2]) << 16 | dword(data[3]) << 24;
 			}
 
 			void Loader::End()
@@ -203,14 +357,14 @@ namespace Nes
 				if (const dword remaining = chunks.Pop())
 				{
 					NST_DEBUG_MSG("unreferenced state chunk data!");
-					stream.Seek( remaining );
+					Seek( remaining );
 				}
 			}
 
 			void Loader::End(dword rollBack)
 			{
 				if (const idword back = -idword(rollBack+4+4) + idword(chunks.Pop()))
-					stream.Seek( back );
+					Seek( back );
 			}
 
 			void Loader::CheckRead(dword length)
@@ -224,31 +378,51 @@ namespace Nes
 			uint Loader::Read8()
 			{
 				CheckRead( 1 );
-				return stream.Read8();
+
+				byte data;
+				Get( &data, 1 );
+
+				return data;
 			}
 
 			uint Loader::Read16()
 			{
 				CheckRead( 2 );
-				return stream.Read16();
+
+				byte data[2];
+				Get( data, 2 );
+
+				return data[0] | uint(data[1]) << 8;
 			}
 
 			dword Loader::Read32()
 			{
 				CheckRead( 4 );
-				return stream.Read32();
+
+				byte data[4];
+				Get( data, 4 );
+
+				return data[0] | uint(data[1]) << 8 | dword(data[2]) << 16 | dword(data[3]) << 24;
 			}
 
 			qaword Loader::Read64()
 			{
 				CheckRead( 8 );
-				return stream.Read64();
+
+				byte data[8];
+				Get( data, 8 );
+
+				return
+				(
+					qaword(data[4] | uint(data[5]) << 8 | dword(data[6]) << 16 | dword(data[7]) << 24) << 32 |
+					dword(data[0] | uint(data[1]) << 8 | dword(data[2]) << 16 | dword(data[3]) << 24)
+				);
 			}
 
 			void Loader::Read(byte* const data,const dword length)
 			{
 				CheckRead( length );
-				stream.Read( data, length );
+				Get( data, length );
 			}
 
 			void Loader::Uncompress(byte* const data,const dword length)
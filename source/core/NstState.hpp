@@ -46,6 +46,7 @@ namespace Nes
 			public:
 
 				Saver(StdStream,bool,bool,dword=0);
+				Saver(byte*,dword,bool);
 				~Saver();
 
 				Saver& Begin(dword);
@@ -63,12 +64,17 @@ namespace Nes
 
 			private:
 
+				void Put(const byte*,dword);
+
 				enum
 				{
 					CHUNK_RESERVE = 8
 				};
 
 				Vector<dword> chunks;
+				byte* const memory;
+				const dword capacity;
+				dword position;
 				const bool useCompression;
 				const bool internal;
 
@@ -92,6 +98,16 @@ namespace Nes
 				{
 					return internal;
 				}
+
+				dword Size() const
+				{
+					return position;
+				}
+
+				bool Overflowed() const
+				{
+					return position > capacity;
+				}
 			};
 
 			class Loader
@@ -99,6 +115,7 @@ namespace Nes
 			public:
 
 				Loader(StdStream,bool);
+				Loader(const byte*,dword,bool);
 				~Loader();
 
 				dword Begin();
@@ -147,6 +164,8 @@ namespace Nes
 			private:
 
 				void CheckRead(dword);
+				void Get(byte*,dword);
+				void Seek(idword);
 
 				enum
 				{
@@ -154,6 +173,9 @@ namespace Nes
 				};
 
 				Vector<dword> chunks;
+				const byte* const memory;
+				const dword capacity;
+				dword position;
 				const bool checkCrc;
 
 			public:
@@ -53,6 +53,9 @@ namespace Nes
 
 			public:
 
+				In()
+				: stream(NULL) {}
+
 				explicit In(StdStream s)
 				: stream(s)
 				{
@@ -103,6 +106,9 @@ namespace Nes
 
 			public:
 
+				Out()
+				: stream(NULL) {}
+
 				explicit Out(StdStream s)
 				: stream(s)
 				{
@@ -24,6 +24,7 @@
 
 #include <new>
 #include "NstMachine.hpp"
+#include "NstState.hpp"
 #include "NstTrackerMovie.hpp"
 #include "NstTrackerRewinder.hpp"
 #include "NstImage.hpp"
@@ -41,6 +42,7 @@ namespace Nes
 		:
 		frame           (0),
 		rewinderSound   (false),
+		runAhead        (0),
 		rewinderEnabled (NULL),
 		rewinder        (NULL),
 		movie           (NULL)
@@ -258,6 +260,22 @@ namespace Nes
 			UpdateRewinderState( true );
 		}
 
+		Result Tracker::SetRunAhead(const uint frames)
+		{
+			if (frames > Api::Machine::MAX_RUN_AHEAD)
+				return RESULT_ERR_INVALID_PARAM;
+
+			if (runAhead == frames)
+				return RESULT_NOP;
+
+			runAhead = frames;
+
+			if (!runAhead)
+				runAheadState.Destroy();
+
+			return RESULT_OK;
+		}
+
 		#ifdef NST_MSVC_OPTIMIZE
 		#pragma optimize("", on)
 		#endif
@@ -297,6 +315,41 @@ namespace Nes
 			return IsRewinding() || movie;
 		}
 
+		void Tracker::RunAhead
+		(
+			Machine& machine,
+			Video::Output* const video,
+			Sound::Output* const sound,
+			Input::Controllers* const input
+		)
+		{
+			NST_ASSERT( runAhead && runAhead <= Api::Machine::MAX_RUN_AHEAD );
+
+			machine.Execute( NULL, sound, input, false );
+
+			for (;;)
+			{
+				State::Saver saver( runAheadState.Begin(), runAheadState.Capacity(), true );
+				machine.SaveState( saver );
+
+				if (!saver.Overflowed())
+				{
+					runAheadState.SetTo( saver.Size() );
+					break;
+				}
+
+				runAheadState.Reserve( saver.Size() );
+			}
+
+			for (uint i=1; i < runAhead; ++i)
+				machine.Execute( NULL, NULL, input, false );
+
+			machine.Execute( video, NULL, input );
+
+			State::Loader loader( runAheadState.Begin(), runAheadState.Size(), false );
+			machine.LoadState( loader, false );
+		}
+
 		Result Tracker::Execute
 		(
 			Machine& machine,
@@ -329,6 +382,11 @@ namespace Nes
 								input = NULL;
 							}
 						}
+						else if (runAhead)
+						{
+							RunAhead( machine, video, sound, input );
+							return RESULT_OK;
+						}
 					}
 
 					machine.Execute( video, sound, input );
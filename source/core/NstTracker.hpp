@@ -25,6 +25,10 @@
 #ifndef NST_TRACKER_H
 #define NST_TRACKER_H
 
+#ifndef NST_VECTOR_H
+#include "NstVector.hpp"
+#endif
+
 #ifdef NST_PRAGMA_ONCE
 #pragma once
 #endif
@@ -79,18 +83,23 @@ namespace Nes
 			bool   IsMoviePlaying() const;
 			bool   IsMovieRecording() const;
 
+			Result SetRunAhead(uint);
+
 		private:
 
 			void UpdateRewinderState(bool);
+			void RunAhead(Machine&,Video::Output*,Sound::Output*,Input::Controllers*);
 
 			class Movie;
 			class Rewinder;
 
 			dword frame;
 			ibool rewinderSound;
+			uint runAhead;
 			Machine* rewinderEnabled;
 			Rewinder* rewinder;
 			Movie* movie;
+			Vector<byte> runAheadState;
 
 		public:
 
@@ -113,6 +122,11 @@ namespace Nes
 			{
 				return frame;
 			}
+
+			uint GetRunAhead() const
+			{
+				return runAhead;
+			}
 		};
 	}
 }
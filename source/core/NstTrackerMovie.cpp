@@ -227,7 +227,7 @@ namespace Nes
 			if (region != cpu.GetRegion())
 				throw RESULT_ERR_WRONG_MODE;
 
-			if (crc && prgCrc && crc != prgCrc && Api::User::questionCallback( Api::User::QUESTION_NSV_PRG_CRC_FAIL_CONTINUE ) == Api::User::ANSWER_NO)
+			if (crc && prgCrc && crc != prgCrc && cpu.GetCallbacks()[Api::User::questionCallback]( Api::User::QUESTION_NSV_PRG_CRC_FAIL_CONTINUE ) == Api::User::ANSWER_NO)
 				throw RESULT_ERR_INVALID_CRC;
 
 			return length;
@@ -476,7 +476,7 @@ namespace Nes
 
 			recorder = new Recorder( stream, cpu, prgCrc, append );
 
-			Api::Movie::eventCallback( Api::Movie::EVENT_RECORDING );
+			cpu.GetCallbacks()[Api::Movie::eventCallback]( Api::Movie::EVENT_RECORDING );
 
 			return true;
 		}
@@ -496,7 +496,7 @@ namespace Nes
 
 			player = new Player( stream, cpu, prgCrc );
 
-			Api::Movie::eventCallback( Api::Movie::EVENT_PLAYING );
+			cpu.GetCallbacks()[Api::Movie::eventCallback]( Api::Movie::EVENT_PLAYING );
 
 			return true;
 		}
@@ -538,14 +538,14 @@ namespace Nes
 					delete recorder;
 					recorder = NULL;
 
-					Api::Movie::eventCallback( Api::Movie::EVENT_RECORDING_STOPPED, result );
+					cpu.GetCallbacks()[Api::Movie::eventCallback]( Api::Movie::EVENT_RECORDING_STOPPED, result );
 				}
 				else
 				{
 					delete player;
 					player = NULL;
 
-					Api::Movie::eventCallback( Api::Movie::EVENT_PLAYING_STOPPED, result );
+					cpu.GetCallbacks()[Api::Movie::eventCallback]( Api::Movie::EVENT_PLAYING_STOPPED, result );
 
 					if (NES_FAILED(result))
 						return false;
@@ -86,19 +86,35 @@ namespace Nes
 
 		class Tracker::Rewinder::ReverseSound::Mutex
 		{
+			UserCallbacks& callbacks;
 			Output::LockCallback funcLock;
 			void* userLock;
 			Output::UnlockCallback funcUnlock;
 			void* userUnlock;
+			const bool setLock;
+			const bool setUnlock;
+
+			template<typename T>
+			void Restore(const T& global,typename T::Function function,void* userdata,bool set) const
+			{
+				if (set)
+					callbacks.Set( global, function, userdata );
+				else
+					callbacks.Unset( global );
+			}
 
 		public:
 
-			Mutex()
+			explicit Mutex(Cpu& cpu)
+			:
+			callbacks (cpu.GetCallbacks()),
+			setLock   (callbacks.IsSet( Output::lockCallback )),
+			setUnlock (callbacks.IsSet( Output::unlockCallback ))
 			{
-				Output::lockCallback.Get( funcLock, userLock );
-				Output::unlockCallback.Get( funcUnlock, userUnlock );
-				Output::lockCallback.Set( NULL, NULL );
-				Output::unlockCallback.Set( NULL, NULL );
+				callbacks[Output::lockCallback].Get( funcLock, userLock );
+				callbacks[Output::unlockCallback].Get( funcUnlock, userUnlock );
+				callbacks.Set( Output::lockCallback, NULL, NULL );
+				callbacks.Set( Output::unlockCallback, NULL, NULL );
 			}
 
 			bool Lock(Output& output) const
@@ -114,8 +130,8 @@ namespace Nes
 
 			~Mutex()
 			{
-				Output::lockCallback.Set( funcLock, userLock );
-				Output::unlockCallback.Set( funcUnlock, userUnlock );
+				Restore( Output::lockCallback, funcLock, userLock, setLock );
+				Restore( Output::unlockCallback, funcUnlock, userUnlock, setUnlock );
 			}
 		};
 
@@ -218,7 +234,7 @@ namespace Nes
 			if (rewinding)
 			{
 				rewinding = false;
-				Api::Rewinder::stateCallback( Api::Rewinder::STOPPED );
+				cpu.GetCallbacks()[Api::Rewinder::stateCallback]( Api::Rewinder::STOPPED );
 			}
 
 			uturn = false;
@@ -687,7 +703,7 @@ namespace Nes
 							key = NextKey();
 							key->BeginForward( emulator, NULL, emuLoadState );
 
-							Api::Rewinder::stateCallback( Api::Rewinder::STOPPED );
+							cpu.GetCallbacks()[Api::Rewinder::stateCallback]( Api::Rewinder::STOPPED );
 
 							LinkPorts();
 						}
@@ -699,7 +715,7 @@ namespace Nes
 						video.Flush( videoMutex );
 						video.Store();
 
-						const ReverseSound::Mutex soundMutex;
+						const ReverseSound::Mutex soundMutex( cpu );
 						sound.Flush( soundOut, soundMutex );
 						soundOut = sound.Store();
 
@@ -719,7 +735,7 @@ namespace Nes
 
 		void Tracker::Rewinder::ChangeDirection()
 		{
-			Api::Rewinder::stateCallback( Api::Rewinder::PREPARING );
+			cpu.GetCallbacks()[Api::Rewinder::stateCallback]( Api::Rewinder::PREPARING );
 
 			uturn = false;
 
@@ -738,7 +754,7 @@ namespace Nes
 
 				{
 					const ReverseVideo::Mutex videoMutex( video );
-					const ReverseSound::Mutex soundMutex;
+					const ReverseSound::Mutex soundMutex( cpu );
 
 					for (uint i=0; i < NUM_FRAMES; ++i)
 					{
@@ -758,7 +774,7 @@ namespace Nes
 						throw RESULT_ERR_CORRUPT_FILE;
 				}
 
-				Api::Rewinder::stateCallback( Api::Rewinder::REWINDING );
+				cpu.GetCallbacks()[Api::Rewinder::stateCallback]( Api::Rewinder::REWINDING );
 			}
 			else
 			{
@@ -781,7 +797,7 @@ namespace Nes
 				video.End();
 				sound.End();
 
-				Api::Rewinder::stateCallback( Api::Rewinder::STOPPED );
+				cpu.GetCallbacks()[Api::Rewinder::stateCallback]( Api::Rewinder::STOPPED );
 			}
 		}
 
@@ -31,15 +31,19 @@
 #include "NstVideoRenderer.hpp"
 #include "NstVideoFilterHqX.hpp"
 
+#ifdef NST_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace Nes
 {
 	namespace Core
 	{
 		namespace Video
 		{
-			void Renderer::FilterHqX::Blit(const Input& input,const Output& output,uint)
+			void Renderer::FilterHqX::Blit(const Input& input,const Output& output,uint,uint first,uint last)
 			{
-				(*this.*path)( input, output );
+				(*this.*path)( input, output, first, last );
 			}
 
 			template<dword R,dword G,dword B>
@@ -152,186 +156,329 @@ namespace Nes
 				}
 			};
 
+			void Renderer::FilterHqX::Fill(Row& row,const Input& input,const uint y) const
+			{
+				const Input::Pixel* const NST_RESTRICT src = input.pixels + y * WIDTH;
+
+				for (uint x=0; x < WIDTH; ++x)
+				{
+					row.w[x+1] = input.palette[src[x]];
+					row.yuv[x+1] = lut.yuv[row.w[x+1]];
+				}
+
+				row.w[0] = row.w[1];
+				row.yuv[0] = row.yuv[1];
+				row.w[WIDTH+1] = row.w[WIDTH];
+				row.yuv[WIDTH+1] = row.yuv[WIDTH];
+			}
+
+		#ifdef NST_SSE2
+
+			namespace
+			{
+				inline __m128i HqxFlag(const __m128i w,const __m128i yuv,const uint* nw,const dword* nyuv,const __m128i mask,const dword bit,__m128i& solid)
+				{
+					const __m128i same = _mm_cmpeq_epi32( w, _mm_loadu_si128(reinterpret_cast<const __m128i*>(nw)) );
+
+					solid = _mm_and_si128( solid, same );
+
+					return _mm_andnot_si128
+					(
+						_mm_or_si128
+						(
+							same,
+							_mm_cmpeq_epi32( _mm_and_si128(_mm_sub_epi32(yuv,_mm_loadu_si128(reinterpret_cast<const __m128i*>(nyuv))),mask), _mm_setzero_si128() )
+						),
+						_mm_set1_epi32( bit )
+					);
+				}
+			}
+
+			void Renderer::FilterHqX::Pattern(const Row& above,const Row& line,const Row& below,dword* const NST_RESTRICT dst)
+			{
+				const __m128i mask = _mm_set1_epi32( Lut::YUV_MASK );
+
+				for (uint x=0; x < WIDTH; x += 4)
+				{
+					const __m128i w = _mm_loadu_si128( reinterpret_cast<const __m128i*>(line.w+x+1) );
+					const __m128i yuv = _mm_loadu_si128( reinterpret_cast<const __m128i*>(line.yuv+x+1) );
+
+					__m128i solid = _mm_set1_epi32( -1 );
+					__m128i pattern = _mm_setzero_si128();
+
+					pattern = _mm_or_si128( pattern, HqxFlag( w, yuv, above.w+x+0, above.yuv+x+0, mask, 0x01, solid ) );
+					pattern = _mm_or_si128( pattern, HqxFlag( w, yuv, above.w+x+1, above.yuv+x+1, mask, 0x02, solid ) );
+					pattern = _mm_or_si128( pattern, HqxFlag( w, yuv, above.w+x+2, above.yuv+x+2, mask, 0x04, solid ) );
+					pattern = _mm_or_si128( pattern, HqxFlag( w, yuv, line.w+x+0,  line.yuv+x+0,  mask, 0x08, solid ) );
+					pattern = _mm_or_si128( pattern, HqxFlag( w, yuv, line.w+x+2,  line.yuv+x+2,  mask, 0x10, solid ) );
+					pattern = _mm_or_si128( pattern, HqxFlag( w, yuv, below.w+x+0, below.yuv+x+0, mask, 0x20, solid ) );
+					pattern = _mm_or_si128( pattern, HqxFlag( w, yuv, below.w+x+1, below.yuv+x+1, mask, 0x40, solid ) );
+					pattern = _mm_or_si128( pattern, HqxFlag( w, yuv, below.w+x+2, below.yuv+x+2, mask, 0x80, solid ) );
+
+					_mm_storeu_si128( reinterpret_cast<__m128i*>(dst+x), _mm_or_si128(pattern,_mm_and_si128(solid,_mm_set1_epi32(SOLID))) );
+				}
+			}
+
+		#else
+
+			void Renderer::FilterHqX::Pattern(const Row& above,const Row& line,const Row& below,dword* const NST_RESTRICT dst)
+			{
+				for (uint x=0; x < WIDTH; ++x)
+				{
+					const uint w = line.w[x+1];
+					const dword yuv = line.yuv[x+1];
+
+					dst[x] =
+					(
+						(w != above.w[x+0] && ((yuv - above.yuv[x+0]) & Lut::YUV_MASK) ? 0x01U : 0x0U) |
+						(w != above.w[x+1] && ((yuv - above.yuv[x+1]) & Lut::YUV_MASK) ? 0x02U : 0x0U) |
+						(w != above.w[x+2] && ((yuv - above.yuv[x+2]) & Lut::YUV_MASK) ? 0x04U : 0x0U) |
+						(w != line.w[x+0]  && ((yuv - line.yuv[x+0])  & Lut::YUV_MASK) ? 0x08U : 0x0U) |
+						(w != line.w[x+2]  && ((yuv - line.yuv[x+2])  & Lut::YUV_MASK) ? 0x10U : 0x0U) |
+						(w != below.w[x+0] && ((yuv - below.yuv[x+0]) & Lut::YUV_MASK) ? 0x20U : 0x0U) |
+						(w != below.w[x+1] && ((yuv - below.yuv[x+1]) & Lut::YUV_MASK) ? 0x40U : 0x0U) |
+						(w != below.w[x+2] && ((yuv - below.yuv[x+2]) & Lut::YUV_MASK) ? 0x80U : 0x0U)
+					);
+
+					if
+					(
+						w == above.w[x+0] && w == above.w[x+1] && w == above.w[x+2] && w == line.w[x+0] &&
+						w == line.w[x+2] && w == below.w[x+0] && w == below.w[x+1] && w == below.w[x+2]
+					)
+						dst[x] = SOLID;
+				}
+			}
+
+		#endif
+
 			template<typename T,dword R,dword G,dword B>
-			void Renderer::FilterHqX::Blit2x(const Input& input,const Output& output) const
+			void Renderer::FilterHqX::Blit2x(const Input& input,const Output& output,const uint first,const uint last) const
 			{
-				const byte* NST_RESTRICT src = reinterpret_cast<const byte*>(input.pixels);
 				const long pitch = output.pitch + output.pitch - (WIDTH*2 * sizeof(T));
 
+				byte* const NST_RESTRICT pixels = static_cast<byte*>(output.pixels) + long(first) * 2 * output.pitch;
+
 				T* NST_RESTRICT dst[2] =
 				{
-					static_cast<T*>(output.pixels) - 2,
-					reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + output.pitch) - 2
+					reinterpret_cast<T*>(pixels) - 2,
+					reinterpret_cast<T*>(pixels + output.pitch) - 2
 				};
 
-				for (uint y=HEIGHT; y; --y)
-				{
-					const uint lines[2] =
-					{
-						y < HEIGHT ? WIDTH * sizeof(Input::Pixel) : 0,
-						y > 1      ? WIDTH * sizeof(Input::Pixel) : 0
-					};
+				Row rows[3];
+
+				const Row* NST_RESTRICT above = rows+0;
+				const Row* NST_RESTRICT line = rows+1;
+				Row* NST_RESTRICT below = rows+2;
 
-					Buffer<T> b;
+				Fill( rows[0], input, first ? first-1 : first );
+				Fill( rows[1], input, first );
 
-					b.w[2] = (b.w[1] = input.palette[*reinterpret_cast<const Input::Pixel*>(src - lines[0])]);
-					b.w[5] = (b.w[4] = input.palette[*reinterpret_cast<const Input::Pixel*>(src)]);
-					b.w[8] = (b.w[7] = input.palette[*reinterpret_cast<const Input::Pixel*>(src + lines[1])]);
+				for (uint y=first; y != last; ++y)
+				{
+					Fill( *below, input, y+1 < HEIGHT ? y+1 : y );
+
+					dword patterns[WIDTH];
+					Pattern( *above, *line, *below, patterns );
 
-					for (uint x=WIDTH; x; )
+					for (uint x=0; x < WIDTH; ++x)
 					{
-						src += sizeof(Input::Pixel);
 						dst[0] += 2;
 						dst[1] += 2;
 
-						b.w[0] = b.w[1];
-						b.w[1] = b.w[2];
-						b.w[3] = b.w[4];
-						b.w[4] = b.w[5];
-						b.w[6] = b.w[7];
-						b.w[7] = b.w[8];
+						Buffer<T> b;
 
-						if (--x)
-						{
-							b.w[2] = input.palette[*reinterpret_cast<const Input::Pixel*>(src - lines[0])];
-							b.w[5] = input.palette[*reinterpret_cast<const Input::Pixel*>(src)];
-							b.w[8] = input.palette[*reinterpret_cast<const Input::Pixel*>(src + lines[1])];
-						}
+						b.w[0] = above->w[x+0];
+						b.w[1] = above->w[x+1];
+						b.w[2] = above->w[x+2];
+						b.w[3] = line->w[x+0];
+						b.w[4] = line->w[x+1];
+						b.w[5] = line->w[x+2];
+						b.w[6] = below->w[x+0];
+						b.w[7] = below->w[x+1];
+						b.w[8] = below->w[x+2];
 
 						b.Convert( lut );
 
-						const uint yuv5 = lut.yuv[b.w[4]];
+						const dword pattern = patterns[x];
 
-						#include "NstVideoFilterHq2x.inl"
+						if (pattern == SOLID)
+						{
+							for (uint i=0; i < 2; ++i)
+							{
+								for (uint j=0; j < 2; ++j)
+									dst[i][j] = b.c[4];
+							}
+						}
+						else
+						{
+							#include "NstVideoFilterHq2x.inl"
+						}
 					}
 
 					dst[0] = reinterpret_cast<T*>(reinterpret_cast<byte*>(dst[0]) + pitch);
 					dst[1] = reinterpret_cast<T*>(reinterpret_cast<byte*>(dst[1]) + pitch);
+
+					Row* const next = const_cast<Row*>(above);
+					above = line;
+					line = below;
+					below = next;
 				}
 			}
 
 			template<typename T,dword R,dword G,dword B>
-			void Renderer::FilterHqX::Blit3x(const Input& input,const Output& output) const
+			void Renderer::FilterHqX::Blit3x(const Input& input,const Output& output,const uint first,const uint last) const
 			{
-				const byte* NST_RESTRICT src = reinterpret_cast<const byte*>(input.pixels);
 				const long pitch = (output.pitch * 2) + output.pitch - (WIDTH*3 * sizeof(T));
 
+				byte* const NST_RESTRICT pixels = static_cast<byte*>(output.pixels) + long(first) * 3 * output.pitch;
+
 				T* NST_RESTRICT dst[3] =
 				{
-					static_cast<T*>(output.pixels) - 3,
-					reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + output.pitch) - 3,
-					reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + output.pitch * 2) - 3
+					reinterpret_cast<T*>(pixels) - 3,
+					reinterpret_cast<T*>(pixels + output.pitch) - 3,
+					reinterpret_cast<T*>(pixels + output.pitch * 2) - 3
 				};
 
-				for (uint y=HEIGHT; y; --y)
-				{
-					const uint lines[2] =
-					{
-						y < HEIGHT ? WIDTH * sizeof(Input::Pixel) : 0,
-						y > 1      ? WIDTH * sizeof(Input::Pixel) : 0
-					};
+				Row rows[3];
 
-					Buffer<T> b;
+				const Row* NST_RESTRICT above = rows+0;
+				const Row* NST_RESTRICT line = rows+1;
+				Row* NST_RESTRICT below = rows+2;
 
-					b.w[2] = (b.w[1] = input.palette[*reinterpret_cast<const Input::Pixel*>(src - lines[0])]);
-					b.w[5] = (b.w[4] = input.palette[*reinterpret_cast<const Input::Pixel*>(src)]);
-					b.w[8] = (b.w[7] = input.palette[*reinterpret_cast<const Input::Pixel*>(src + lines[1])]);
+				Fill( rows[0], input, first ? first-1 : first );
+				Fill( rows[1], input, first );
+
+				for (uint y=first; y != last; ++y)
+				{
+					Fill( *below, input, y+1 < HEIGHT ? y+1 : y );
 
-					for (uint x=WIDTH; x; )
+					dword patterns[WIDTH];
+					Pattern( *above, *line, *below, patterns );
+
+					for (uint x=0; x < WIDTH; ++x)
 					{
-						src += sizeof(Input::Pixel);
 						dst[0] += 3;
 						dst[1] += 3;
 						dst[2] += 3;
 
-						b.w[0] = b.w[1];
-						b.w[1] = b.w[2];
-						b.w[3] = b.w[4];
-						b.w[4] = b.w[5];
-						b.w[6] = b.w[7];
-						b.w[7] = b.w[8];
+						Buffer<T> b;
 
-						if (--x)
-						{
-							b.w[2] = input.palette[*reinterpret_cast<const Input::Pixel*>(src - lines[0])];
-							b.w[5] = input.palette[*reinterpret_cast<const Input::Pixel*>(src)];
-							b.w[8] = input.palette[*reinterpret_cast<const Input::Pixel*>(src + lines[1])];
-						}
+						b.w[0] = above->w[x+0];
+						b.w[1] = above->w[x+1];
+						b.w[2] = above->w[x+2];
+						b.w[3] = line->w[x+0];
+						b.w[4] = line->w[x+1];
+						b.w[5] = line->w[x+2];
+						b.w[6] = below->w[x+0];
+						b.w[7] = below->w[x+1];
+						b.w[8] = below->w[x+2];
 
 						b.Convert( lut );
 
-						const uint yuv5 = lut.yuv[b.w[4]];
+						const dword pattern = patterns[x];
 
-						#include "NstVideoFilterHq3x.inl"
+						if (pattern == SOLID)
+						{
+							for (uint i=0; i < 3; ++i)
+							{
+								for (uint j=0; j < 3; ++j)
+									dst[i][j] = b.c[4];
+							}
+						}
+						else
+						{
+							#include "NstVideoFilterHq3x.inl"
+						}
 					}
 
 					dst[0] = reinterpret_cast<T*>(reinterpret_cast<byte*>(dst[0]) + pitch);
 					dst[1] = reinterpret_cast<T*>(reinterpret_cast<byte*>(dst[1]) + pitch);
 					dst[2] = reinterpret_cast<T*>(reinterpret_cast<byte*>(dst[2]) + pitch);
+
+					Row* const next = const_cast<Row*>(above);
+					above = line;
+					line = below;
+					below = next;
 				}
 			}
 
 			template<typename T,dword R,dword G,dword B>
-			void Renderer::FilterHqX::Blit4x(const Input& input,const Output& output) const
+			void Renderer::FilterHqX::Blit4x(const Input& input,const Output& output,const uint first,const uint last) const
 			{
-				const byte* NST_RESTRICT src = reinterpret_cast<const byte*>(input.pixels);
 				const long pitch = (output.pitch * 3) + output.pitch - (WIDTH*4 * sizeof(T));
 
+				byte* const NST_RESTRICT pixels = static_cast<byte*>(output.pixels) + long(first) * 4 * output.pitch;
+
 				T* NST_RESTRICT dst[4] =
 				{
-					static_cast<T*>(output.pixels) - 4,
-					reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + output.pitch) - 4,
-					reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + output.pitch * 2) - 4,
-					reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + output.pitch * 3) - 4
+					reinterpret_cast<T*>(pixels) - 4,
+					reinterpret_cast<T*>(pixels + output.pitch) - 4,
+					reinterpret_cast<T*>(pixels + output.pitch * 2) - 4,
+					reinterpret_cast<T*>(pixels + output.pitch * 3) - 4
 				};
 
-				for (uint y=HEIGHT; y; --y)
-				{
-					const uint lines[2] =
-					{
-						y < HEIGHT ? WIDTH * sizeof(Input::Pixel) : 0,
-						y > 1      ? WIDTH * sizeof(Input::Pixel) : 0
-					};
+				Row rows[3];
 
-					Buffer<T> b;
+				const Row* NST_RESTRICT above = rows+0;
+				const Row* NST_RESTRICT line = rows+1;
+				Row* NST_RESTRICT below = rows+2;
 
-					b.w[2] = (b.w[1] = input.palette[*reinterpret_cast<const Input::Pixel*>(src - lines[0])]);
-					b.w[5] = (b.w[4] = input.palette[*reinterpret_cast<const Input::Pixel*>(src)]);
-					b.w[8] = (b.w[7] = input.palette[*reinterpret_cast<const Input::Pixel*>(src + lines[1])]);
+				Fill( rows[0], input, first ? first-1 : first );
+				Fill( rows[1], input, first );
+
+				for (uint y=first; y != last; ++y)
+				{
+					Fill( *below, input, y+1 < HEIGHT ? y+1 : y );
 
-					for (uint x=WIDTH; x; )
+					dword patterns[WIDTH];
+					Pattern( *above, *line, *below, patterns );
+
+					for (uint x=0; x < WIDTH; ++x)
 					{
-						src += sizeof(Input::Pixel);
 						dst[0] += 4;
 						dst[1] += 4;
 						dst[2] += 4;
 						dst[3] += 4;
 
-						b.w[0] = b.w[1];
-						b.w[1] = b.w[2];
-						b.w[3] = b.w[4];
-						b.w[4] = b.w[5];
-						b.w[6] = b.w[7];
-						b.w[7] = b.w[8];
+						Buffer<T> b;
 
-						if (--x)
-						{
-							b.w[2] = input.palette[*reinterpret_cast<const Input::Pixel*>(src - lines[0])];
-							b.w[5] = input.palette[*reinterpret_cast<const Input::Pixel*>(src)];
-							b.w[8] = input.palette[*reinterpret_cast<const Input::Pixel*>(src + lines[1])];
-						}
+						b.w[0] = above->w[x+0];
+						b.w[1] = above->w[x+1];
+						b.w[2] = above->w[x+2];
+						b.w[3] = line->w[x+0];
+						b.w[4] = line->w[x+1];
+						b.w[5] = line->w[x+2];
+						b.w[6] = below->w[x+0];
+						b.w[7] = below->w[x+1];
+						b.w[8] = below->w[x+2];
 
 						b.Convert( lut );
 
-						const uint yuv5 = lut.yuv[b.w[4]];
+						const dword pattern = patterns[x];
 
-						#include "NstVideoFilterHq4x.inl"
+						if (pattern == SOLID)
+						{
+							for (uint i=0; i < 4; ++i)
+							{
+								for (uint j=0; j < 4; ++j)
+									dst[i][j] = b.c[4];
+							}
+						}
+						else
+						{
+							#include "NstVideoFilterHq4x.inl"
+						}
 					}
 
 					dst[0] = reinterpret_cast<T*>(reinterpret_cast<byte*>(dst[0]) + pitch);
 					dst[1] = reinterpret_cast<T*>(reinterpret_cast<byte*>(dst[1]) + pitch);
 					dst[2] = reinterpret_cast<T*>(reinterpret_cast<byte*>(dst[2]) + pitch);
 					dst[3] = reinterpret_cast<T*>(reinterpret_cast<byte*>(dst[3]) + pitch);
+
+					Row* const next = const_cast<Row*>(above);
+					above = line;
+					line = below;
+					below = next;
 				}
 			}
 
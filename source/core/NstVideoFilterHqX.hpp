@@ -48,11 +48,11 @@ namespace Nes
 
 				~FilterHqX() {}
 
-				typedef void (FilterHqX::*Path)(const Input&,const Output&) const;
+				typedef void (FilterHqX::*Path)(const Input&,const Output&,uint,uint) const;
 
 				static Path GetPath(const RenderState&);
 
-				void Blit(const Input&,const Output&,uint);
+				void Blit(const Input&,const Output&,uint,uint,uint);
 				void Transform(const byte (&)[PALETTE][3],Input::Palette&) const;
 
 				template<dword R,dword G,dword B> static dword Interpolate1(dword,dword);
@@ -68,14 +68,28 @@ namespace Nes
 
 				inline dword Diff(uint,uint) const;
 
+				enum
+				{
+					SOLID = 0x100
+				};
+
+				struct Row
+				{
+					uint w[WIDTH+2];
+					dword yuv[WIDTH+2];
+				};
+
+				void Fill(Row&,const Input&,uint) const;
+				static void Pattern(const Row&,const Row&,const Row&,dword*);
+
 				template<typename T,dword R,dword G,dword B>
-				void Blit2x(const Input&,const Output&) const;
+				void Blit2x(const Input&,const Output&,uint,uint) const;
 
 				template<typename T,dword R,dword G,dword B>
-				void Blit3x(const Input&,const Output&) const;
+				void Blit3x(const Input&,const Output&,uint,uint) const;
 
 				template<typename T,dword R,dword G,dword B>
-				void Blit4x(const Input&,const Output&) const;
+				void Blit4x(const Input&,const Output&,uint,uint) const;
 
 				template<typename T>
 				struct Buffer;
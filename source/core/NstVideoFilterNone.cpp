@@ -26,19 +26,88 @@
 #include "NstVideoRenderer.hpp"
 #include "NstVideoFilterNone.hpp"
 
+#ifdef NST_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace Nes
 {
 	namespace Core
 	{
 		namespace Video
 		{
+		#ifdef NST_SSE2
+
+			namespace
+			{
+				inline void NoneStore(dword* const dst,const __m128i a,const __m128i b)
+				{
+					_mm_storeu_si128( reinterpret_cast<__m128i*>(dst+0), a );
+					_mm_storeu_si128( reinterpret_cast<__m128i*>(dst+4), b );
+				}
+
+				inline void NoneStore(word* const dst,const __m128i a,const __m128i b)
+				{
+					_mm_storeu_si128
+					(
+						reinterpret_cast<__m128i*>(dst),
+						_mm_packs_epi32( _mm_srai_epi32( _mm_slli_epi32( a, 16 ), 16 ), _mm_srai_epi32( _mm_slli_epi32( b, 16 ), 16 ) )
+					);
+				}
+			}
+
+			template<typename T>
+			void Renderer::FilterNone::BlitLines(const Input& input,const Output& output,const uint first,const uint last) const
+			{
+				const Input::Palette& palette = input.palette;
+
+				for (uint y=first; y < last; ++y)
+				{
+					if (dirty && !dirty[y])
+						continue;
+
+					const Input::Pixel* NST_RESTRICT src = input.pixels + y * WIDTH;
+					T* NST_RESTRICT dst = reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + long(y) * output.pitch);
+
+					for (uint x=WIDTH/8; x; --x, src += 8, dst += 8)
+					{
+						const __m128i pixels = _mm_loadu_si128( reinterpret_cast<const __m128i*>(src) );
+
+						if (_mm_movemask_epi8( _mm_cmpeq_epi16( pixels, _mm_set1_epi16( short(src[0]) ) ) ) == 0xFFFF)
+						{
+							const __m128i color = _mm_set1_epi32( palette[src[0]] );
+							NoneStore( dst, color, color );
+						}
+						else
+						{
+							NoneStore
+							(
+								dst,
+								_mm_set_epi32( palette[src[3]], palette[src[2]], palette[src[1]], palette[src[0]] ),
+								_mm_set_epi32( palette[src[7]], palette[src[6]], palette[src[5]], palette[src[4]] )
+							);
+						}
+					}
+				}
+			}
+
+			void Renderer::FilterNone::Blit(const Input& input,const Output& output,uint,uint first,uint last)
+			{
+				if (format.bpp == 32)
+					BlitLines<dword>( input, output, first, last );
+				else
+					BlitLines<word>( input, output, first, last );
+			}
+
+		#else
+
 			template<typename T>
-			void Renderer::FilterNone::BlitAligned(const Input& input,const Output& output)
+			void Renderer::FilterNone::BlitAligned(const Input& input,const Output& output,const uint first,const uint last)
 			{
-				const Input::Pixel* NST_RESTRICT src = input.pixels;
-				T* NST_RESTRICT dst = static_cast<T*>(output.pixels);
+				const Input::Pixel* NST_RESTRICT src = input.pixels + first * WIDTH;
+				T* NST_RESTRICT dst = static_cast<T*>(output.pixels) + first * WIDTH;
 
-				for (uint prefetched=*src++, i=PIXELS; i; --i)
+				for (uint prefetched=*src++, i=(last-first)*WIDTH; i; --i)
 				{
 					const dword reg = input.palette[prefetched];
 					prefetched = *src++;
@@ -47,14 +116,14 @@ namespace Nes
 			}
 
 			template<typename T>
-			void Renderer::FilterNone::BlitUnaligned(const Input& input,const Output& output)
+			void Renderer::FilterNone::BlitUnaligned(const Input& input,const Output& output,const uint first,const uint last)
 			{
-				const Input::Pixel* NST_RESTRICT src = input.pixels;
-				T* NST_RESTRICT dst = static_cast<T*>(output.pixels);
+				const Input::Pixel* NST_RESTRICT src = input.pixels + first * WIDTH;
+				T* NST_RESTRICT dst = reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + long(first) * output.pitch);
 
 				const long pad = output.pitch - WIDTH * sizeof(T);
 
-				for (uint prefetched=*src++, y=HEIGHT; y; --y)
+				for (uint prefetched=*src++, y=last-first; y; --y)
 				{
 					for (uint x=WIDTH; x; --x)
 					{
@@ -67,24 +136,49 @@ namespace Nes
 				}
 			}
 
-			void Renderer::FilterNone::Blit(const Input& input,const Output& output,uint)
+			template<typename T>
+			void Renderer::FilterNone::BlitLines(const Input& input,const Output& output,const uint first,const uint last) const
 			{
-				if (format.bpp == 32)
+				for (uint y=first; y < last; ++y)
+				{
+					if (dirty[y])
+					{
+						const Input::Pixel* NST_RESTRICT src = input.pixels + y * WIDTH;
+						T* NST_RESTRICT dst = reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + long(y) * output.pitch);
+
+						for (uint x=WIDTH; x; --x)
+							*dst++ = input.palette[*src++];
+					}
+				}
+			}
+
+			void Renderer::FilterNone::Blit(const Input& input,const Output& output,uint,uint first,uint last)
+			{
+				if (dirty)
+				{
+					if (format.bpp == 32)
+						BlitLines<dword>( input, output, first, last );
+					else
+						BlitLines<word>( input, output, first, last );
+				}
+				else if (format.bpp == 32)
 				{
 					if (output.pitch == WIDTH * sizeof(dword))
-						BlitAligned<dword>( input, output );
+						BlitAligned<dword>( input, output, first, last );
 					else
-						BlitUnaligned<dword>( input, output );
+						BlitUnaligned<dword>( input, output, first, last );
 				}
 				else
 				{
 					if (output.pitch == WIDTH * sizeof(word))
-						BlitAligned<word>( input, output );
+						BlitAligned<word>( input, output, first, last );
 					else
-						BlitUnaligned<word>( input, output );
+						BlitUnaligned<word>( input, output, first, last );
 				}
 			}
 
+		#endif
+
 			#ifdef NST_MSVC_OPTIMIZE
 			#pragma optimize("s", on)
 			#endif
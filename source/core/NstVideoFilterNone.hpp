@@ -47,13 +47,20 @@ namespace Nes
 
 				~FilterNone() {}
 
-				void Blit(const Input&,const Output&,uint);
+				void Blit(const Input&,const Output&,uint,uint,uint);
+
+			#ifndef NST_SSE2
+
+				template<typename T>
+				static void BlitAligned(const Input&,const Output&,uint,uint);
 
 				template<typename T>
-				static void BlitAligned(const Input&,const Output&);
+				static void BlitUnaligned(const Input&,const Output&,uint,uint);
+
+			#endif
 
 				template<typename T>
-				static void BlitUnaligned(const Input&,const Output&);
+				void BlitLines(const Input&,const Output&,uint,uint) const;
 			};
 		}
 	}
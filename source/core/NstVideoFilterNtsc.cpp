@@ -22,73 +22,221 @@
 //
 ////////////////////////////////////////////////////////////////////////////////////////
 
+#include <cstring>
+#include <new>
 #include "NstAssert.hpp"
 #include "NstVideoRenderer.hpp"
 #include "NstVideoFilterNtsc.hpp"
 #include "NstFpuPrecision.hpp"
 
+#ifdef NST_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace Nes
 {
 	namespace Core
 	{
 		namespace Video
 		{
-			void Renderer::FilterNtsc::Blit(const Input& input,const Output& output,uint phase)
+			void Renderer::FilterNtsc::Blit(const Input& input,const Output& output,uint phase,uint first,uint last)
 			{
-				(*this.*path)( input, output, phase );
+				(*this.*path)( input, output, phase, first, last );
 			}
 
 			template<typename Pixel,uint BITS>
-			void Renderer::FilterNtsc::BlitType(const Input& input,const Output& output,uint phase) const
+			void Renderer::FilterNtsc::BlitType(const Input& input,const Output& output,uint phase,const uint first,const uint last) const
 			{
 				NST_ASSERT( phase < 3 );
-				
+
 				const uint bgcolor = this->bgColor;
-				const Input::Pixel* NST_RESTRICT src = input.pixels;
-				Pixel* NST_RESTRICT dst = static_cast<Pixel*>(output.pixels);
-				const long pad = output.pitch - (NTSC_WIDTH-7) * sizeof(Pixel);
+				const Input::Pixel* NST_RESTRICT src = input.pixels + first * WIDTH;
+				Pixel* NST_RESTRICT dst = reinterpret_cast<Pixel*>(static_cast<byte*>(output.pixels) + long(first) * output.pitch);
+
+				phase = ((phase & lut.noFieldMerging) + first) % 3;
+
+				for (uint y=first; y != last; ++y)
+				{
+					if (!dirty || dirty[y])
+					{
+						if (cache)
+						{
+							Cache::Line& line = cache->lines[phase][y];
+
+							if (line.bgColor != bgcolor || std::memcmp( line.pixels, src, sizeof(line.pixels) ))
+							{
+								line.bgColor = bgcolor;
+								std::memcpy( line.pixels, src, sizeof(line.pixels) );
+								BlitLine<Pixel,BITS>( src, reinterpret_cast<Pixel*>(line.output), phase, bgcolor );
+							}
+
+							std::memcpy( dst, line.output, NTSC_WIDTH * sizeof(Pixel) );
+						}
+						else
+						{
+							BlitLine<Pixel,BITS>( src, dst, phase, bgcolor );
+						}
+					}
+
+					src += WIDTH;
+					dst = reinterpret_cast<Pixel*>(reinterpret_cast<byte*>(dst) + output.pitch);
+					phase = (phase + 1) % 3;
+				}
+			}
+
+		#ifdef NST_SSE2
+
+			template<typename Pixel,uint BITS>
+			void Renderer::FilterNtsc::BlitLine(const Input::Pixel* NST_RESTRICT src,Pixel* NST_RESTRICT dst,const uint phase,const uint bgcolor) const
+			{
+				const dword* const NST_RESTRICT table = kernels + phase * (PALETTE * KERNEL_SIZE);
+
+				const __m128i mask = _mm_set1_epi32( nes_ntsc_clamp_mask );
+				const __m128i add = _mm_set1_epi32( nes_ntsc_clamp_add );
 
-				phase &= lut.noFieldMerging;
+				const dword* const bg = table + bgcolor * KERNEL_SIZE;
 
-				for (uint y=HEIGHT; y; --y)
+				const dword* p0 = bg;
+				const dword* p1 = bg + 24;
+				const dword* p2 = table + *src++ * KERNEL_SIZE + 48;
+				const dword* q1 = bg + 24;
+				const dword* q2 = bg + 48;
+
+				for (uint n=0; n < NTSC_CHUNKS; ++n, dst += 7)
 				{
-					NES_NTSC_BEGIN_ROW( &lut, phase, bgcolor, bgcolor, *src++ );
+					const dword* n0;
+					const dword* n1;
+					const dword* n2;
+
+					if (n < NTSC_CHUNKS-1)
+					{
+						n0 = table + src[0] * KERNEL_SIZE;
+						n1 = table + src[1] * KERNEL_SIZE + 24;
+						n2 = table + src[2] * KERNEL_SIZE + 48;
+						src += 3;
+					}
+					else
+					{
+						n0 = bg;
+						n1 = bg + 24;
+						n2 = bg + 48;
+					}
+
+					__m128i v[2];
+
+					for (uint i=0; i < 2; ++i)
+					{
+						__m128i io = _mm_add_epi32
+						(
+							_mm_add_epi32
+							(
+								_mm_add_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i*>(n0 + i*4) ), _mm_loadu_si128( reinterpret_cast<const __m128i*>(p0 + 8 + i*4) ) ),
+								_mm_add_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i*>(n1 + i*4) ), _mm_loadu_si128( reinterpret_cast<const __m128i*>(p1 + 8 + i*4) ) )
+							),
+							_mm_add_epi32
+							(
+								_mm_add_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i*>(q1 + 16 + i*4) ), _mm_loadu_si128( reinterpret_cast<const __m128i*>(n2 + i*4) ) ),
+								_mm_add_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i*>(p2 + 8 + i*4) ), _mm_loadu_si128( reinterpret_cast<const __m128i*>(q2 + 16 + i*4) ) )
+							)
+						);
 
-					for (const Input::Pixel* const end=src+(NTSC_WIDTH/7*3-3); src != end; src += 3, dst += 7)
+						const __m128i sub = _mm_and_si128( _mm_srli_epi32( io, 9 ), mask );
+						__m128i clamp = _mm_sub_epi32( add, sub );
+						io = _mm_or_si128( io, clamp );
+						clamp = _mm_sub_epi32( clamp, sub );
+						io = _mm_and_si128( io, clamp );
+
+						if (BITS == 32)
+						{
+							v[i] = _mm_or_si128
+							(
+								_mm_or_si128
+								(
+									_mm_and_si128( _mm_srli_epi32( io, 5 ), _mm_set1_epi32( 0xFF0000 ) ),
+									_mm_and_si128( _mm_srli_epi32( io, 3 ), _mm_set1_epi32( 0x00FF00 ) )
+								),
+								_mm_and_si128( _mm_srli_epi32( io, 1 ), _mm_set1_epi32( 0x0000FF ) )
+							);
+						}
+						else
+						{
+							v[i] = _mm_or_si128
+							(
+								_mm_or_si128
+								(
+									_mm_and_si128( _mm_srli_epi32( io, BITS == 16 ? 13 : 14 ), _mm_set1_epi32( BITS == 16 ? 0xF800 : 0x7C00 ) ),
+									_mm_and_si128( _mm_srli_epi32( io, BITS == 16 ? 8 : 9 ), _mm_set1_epi32( BITS == 16 ? 0x07E0 : 0x03E0 ) )
+								),
+								_mm_and_si128( _mm_srli_epi32( io, 4 ), _mm_set1_epi32( 0x001F ) )
+							);
+
+							v[i] = _mm_srai_epi32( _mm_slli_epi32( v[i], 16 ), 16 );
+						}
+					}
+
+					if (BITS == 32)
 					{
-						NES_NTSC_COLOR_IN( 0, src[0] );
-						NES_NTSC_RGB_OUT( 0, dst[0], BITS );
-						NES_NTSC_RGB_OUT( 1, dst[1], BITS );
-
-						NES_NTSC_COLOR_IN( 1, src[1] );
-						NES_NTSC_RGB_OUT( 2, dst[2], BITS );
-						NES_NTSC_RGB_OUT( 3, dst[3], BITS );
-
-						NES_NTSC_COLOR_IN( 2, src[2] );
-						NES_NTSC_RGB_OUT( 4, dst[4], BITS );
-						NES_NTSC_RGB_OUT( 5, dst[5], BITS );
-						NES_NTSC_RGB_OUT( 6, dst[6], BITS );
+						_mm_storeu_si128( reinterpret_cast<__m128i*>(dst), v[0] );
+						_mm_storel_epi64( reinterpret_cast<__m128i*>(dst + 4), v[1] );
+						dst[6] = _mm_cvtsi128_si32( _mm_srli_si128( v[1], 8 ) );
 					}
+					else
+					{
+						const __m128i w = _mm_packs_epi32( v[0], v[1] );
+
+						_mm_storel_epi64( reinterpret_cast<__m128i*>(dst), w );
+						dst[4] = _mm_extract_epi16( w, 4 );
+						dst[5] = _mm_extract_epi16( w, 5 );
+						dst[6] = _mm_extract_epi16( w, 6 );
+					}
+
+					q1 = p1;
+					q2 = p2;
+					p0 = n0;
+					p1 = n1;
+					p2 = n2;
+				}
+			}
+
+		#else
+
+			template<typename Pixel,uint BITS>
+			void Renderer::FilterNtsc::BlitLine(const Input::Pixel* NST_RESTRICT src,Pixel* NST_RESTRICT dst,const uint phase,const uint bgcolor) const
+			{
+				NES_NTSC_BEGIN_ROW( &lut, phase, bgcolor, bgcolor, *src++ );
 
-					NES_NTSC_COLOR_IN( 0, bgcolor );
+				for (const Input::Pixel* const end=src+(NTSC_WIDTH/7*3-3); src != end; src += 3, dst += 7)
+				{
+					NES_NTSC_COLOR_IN( 0, src[0] );
 					NES_NTSC_RGB_OUT( 0, dst[0], BITS );
 					NES_NTSC_RGB_OUT( 1, dst[1], BITS );
 
-					NES_NTSC_COLOR_IN( 1, bgcolor );
+					NES_NTSC_COLOR_IN( 1, src[1] );
 					NES_NTSC_RGB_OUT( 2, dst[2], BITS );
 					NES_NTSC_RGB_OUT( 3, dst[3], BITS );
 
-					NES_NTSC_COLOR_IN( 2, bgcolor );
+					NES_NTSC_COLOR_IN( 2, src[2] );
 					NES_NTSC_RGB_OUT( 4, dst[4], BITS );
 					NES_NTSC_RGB_OUT( 5, dst[5], BITS );
 					NES_NTSC_RGB_OUT( 6, dst[6], BITS );
+				}
 
-					dst = reinterpret_cast<Pixel*>(reinterpret_cast<byte*>(dst) + pad);
+				NES_NTSC_COLOR_IN( 0, bgcolor );
+				NES_NTSC_RGB_OUT( 0, dst[0], BITS );
+				NES_NTSC_RGB_OUT( 1, dst[1], BITS );
 
-					phase = (phase + 1) % 3;
-				}
+				NES_NTSC_COLOR_IN( 1, bgcolor );
+				NES_NTSC_RGB_OUT( 2, dst[2], BITS );
+				NES_NTSC_RGB_OUT( 3, dst[3], BITS );
+
+				NES_NTSC_COLOR_IN( 2, bgcolor );
+				NES_NTSC_RGB_OUT( 4, dst[4], BITS );
+				NES_NTSC_RGB_OUT( 5, dst[5], BITS );
+				NES_NTSC_RGB_OUT( 6, dst[6], BITS );
 			}
 
+		#endif
+
 			#ifdef NST_MSVC_OPTIMIZE
 			#pragma optimize("s", on)
 			#endif
@@ -182,15 +330,76 @@ namespace Nes
 				schar bleed,
 				schar artifacts,
 				schar fringing,
-				bool fieldMerging
+				bool fieldMerging,
+				bool rowCache
 			)
 			:
-			Filter (state),
-			path   (GetPath(state,lut)),
-			lut    (palette,sharpness,resolution,bleed,artifacts,fringing,fieldMerging)
+			Filter  (state),
+			path    (GetPath(state,lut)),
+			lut     (palette,sharpness,resolution,bleed,artifacts,fringing,fieldMerging),
+		#ifdef NST_SSE2
+			kernels (CreateKernels(lut)),
+		#endif
+			cache   (CreateCache(rowCache))
+			{
+			}
+
+			Renderer::FilterNtsc::~FilterNtsc()
+			{
+				delete cache;
+			#ifdef NST_SSE2
+				delete [] kernels;
+			#endif
+			}
+
+			Renderer::FilterNtsc::Cache* Renderer::FilterNtsc::CreateCache(const bool enable)
 			{
+				Cache* const cache = enable ? new (std::nothrow) Cache : NULL;
+
+				if (cache)
+				{
+					for (uint i=0; i < 3; ++i)
+					{
+						for (uint j=0; j < HEIGHT; ++j)
+							cache->lines[i][j].bgColor = ~0U;
+					}
+				}
+
+				return cache;
+			}
+
+		#ifdef NST_SSE2
+
+			dword* Renderer::FilterNtsc::CreateKernels(const Lut& lut)
+			{
+				dword* const kernels = new dword [nes_ntsc_burst_count * PALETTE * KERNEL_SIZE];
+				dword* NST_RESTRICT dst = kernels;
+
+				for (uint burst=0; burst < nes_ntsc_burst_count; ++burst)
+				{
+					for (uint color=0; color < PALETTE; ++color)
+					{
+						const nes_ntsc_rgb_t* const entry = lut.table[color] + burst * nes_ntsc_burst_size;
+
+						for (uint slot=0; slot < 3; ++slot)
+						{
+							for (uint part=0; part < 3; ++part)
+							{
+								for (uint lane=0; lane < 8; ++lane)
+								{
+									const int i = int(part * 7 + lane) - int(slot * 2);
+									*dst++ = (lane < 7 && i >= 0 && i < 14) ? dword(entry[slot * 14 + i]) : 0;
+								}
+							}
+						}
+					}
+				}
+
+				return kernels;
 			}
 
+		#endif
+
 			#ifdef NST_MSVC_OPTIMIZE
 			#pragma optimize("", on)
 			#endif
@@ -41,25 +41,41 @@ namespace Nes
 			{
 			public:
 
-				FilterNtsc(const RenderState&,const byte (&)[PALETTE][3],schar,schar,schar,schar,schar,bool);
+				FilterNtsc(const RenderState&,const byte (&)[PALETTE][3],schar,schar,schar,schar,schar,bool,bool);
 
 				static bool Check(const RenderState&);
 
 			private:
 
-				~FilterNtsc() {}
+				~FilterNtsc();
 
 				enum
 				{
-					NTSC_WIDTH = 602
+					NTSC_WIDTH = 602,
+					NTSC_CHUNKS = NTSC_WIDTH / 7
 				};
 
-				typedef void (FilterNtsc::*Path)(const Input&,const Output&,uint) const;
+				struct Cache
+				{
+					struct Line
+					{
+						Input::Pixel pixels[WIDTH];
+						uint bgColor;
+						dword output[NTSC_WIDTH];
+					};
+
+					Line lines[3][HEIGHT];
+				};
+
+				typedef void (FilterNtsc::*Path)(const Input&,const Output&,uint,uint,uint) const;
 
-				void Blit(const Input&,const Output&,uint);
+				void Blit(const Input&,const Output&,uint,uint,uint);
+
+				template<typename T,uint BITS>
+				void BlitType(const Input&,const Output&,uint,uint,uint) const;
 
 				template<typename T,uint BITS>
-				void BlitType(const Input&,const Output&,uint) const;
+				void BlitLine(const Input::Pixel* NST_RESTRICT,T* NST_RESTRICT,uint,uint) const;
 
 				class Lut : public nes_ntsc_t
 				{
@@ -79,9 +95,25 @@ namespace Nes
 				};
 
 				static Path GetPath(const RenderState&,const Lut&);
+				static Cache* CreateCache(bool);
+
+			#ifdef NST_SSE2
+
+				enum
+				{
+					KERNEL_SIZE = 3*3*8
+				};
+
+				static dword* CreateKernels(const Lut&);
+
+			#endif
 
 				const Path path;
 				const Lut lut;
+			#ifdef NST_SSE2
+				dword* const kernels;
+			#endif
+				Cache* const cache;
 			};
 		}
 	}
@@ -30,17 +30,212 @@
 #include "NstVideoRenderer.hpp"
 #include "NstVideoFilterScaleX.hpp"
 
+#ifdef NST_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace Nes
 {
 	namespace Core
 	{
 		namespace Video
 		{
-			void Renderer::FilterScaleX::Blit(const Input& input,const Output& output,uint)
+			void Renderer::FilterScaleX::Blit(const Input& input,const Output& output,uint,uint first,uint last)
+			{
+				path( input, output, first, last );
+			}
+
+		#ifdef NST_SSE2
+
+			namespace
+			{
+				inline __m128i ScaleXSelect(const __m128i mask,const __m128i a,const __m128i b)
+				{
+					return _mm_or_si128( _mm_and_si128( mask, a ), _mm_andnot_si128( mask, b ) );
+				}
+
+				inline __m128i ScaleXPack(const __m128i a,const __m128i b)
+				{
+					return _mm_packs_epi32
+					(
+						_mm_srai_epi32( _mm_slli_epi32( a, 16 ), 16 ),
+						_mm_srai_epi32( _mm_slli_epi32( b, 16 ), 16 )
+					);
+				}
+
+				inline void ScaleXStore2(dword* const dst,const __m128i a,const __m128i b)
+				{
+					_mm_storeu_si128( reinterpret_cast<__m128i*>(dst+0), a );
+					_mm_storeu_si128( reinterpret_cast<__m128i*>(dst+4), b );
+				}
+
+				inline void ScaleXStore2(word* const dst,const __m128i a,const __m128i b)
+				{
+					_mm_storeu_si128( reinterpret_cast<__m128i*>(dst), ScaleXPack( a, b ) );
+				}
+
+				inline void ScaleXStore3(dword* const dst,const __m128i a,const __m128i b,const __m128i c)
+				{
+					_mm_storeu_si128( reinterpret_cast<__m128i*>(dst+0), a );
+					_mm_storeu_si128( reinterpret_cast<__m128i*>(dst+4), b );
+					_mm_storeu_si128( reinterpret_cast<__m128i*>(dst+8), c );
+				}
+
+				inline void ScaleXStore3(word* const dst,const __m128i a,const __m128i b,const __m128i c)
+				{
+					_mm_storeu_si128( reinterpret_cast<__m128i*>(dst), ScaleXPack( a, b ) );
+					_mm_storel_epi64( reinterpret_cast<__m128i*>(dst+8), ScaleXPack( c, c ) );
+				}
+
+				template<typename T>
+				inline void ScaleXStore3x(T* const dst,const __m128i a,const __m128i b,const __m128i c)
+				{
+					const __m128 ab = _mm_castsi128_ps( _mm_unpackhi_epi32( a, b ) );
+
+					ScaleXStore3
+					(
+						dst,
+						_mm_castps_si128( _mm_shuffle_ps( _mm_castsi128_ps(_mm_unpacklo_epi32(a,b)), _mm_castsi128_ps(_mm_unpacklo_epi32(c,a)), _MM_SHUFFLE(3,0,1,0) ) ),
+						_mm_castps_si128( _mm_shuffle_ps( _mm_castsi128_ps(_mm_unpacklo_epi32(b,c)), ab, _MM_SHUFFLE(1,0,3,2) ) ),
+						_mm_castps_si128( _mm_shuffle_ps( _mm_castsi128_ps(_mm_unpackhi_epi32(c,a)), _mm_castsi128_ps(_mm_unpackhi_epi32(b,c)), _MM_SHUFFLE(3,2,3,0) ) )
+					);
+				}
+			}
+
+			const dword* Renderer::FilterScaleX::GetRow(Row (&rows)[3],const Input& input,const uint y)
+			{
+				Row& row = rows[y % 3];
+
+				if (row.line != y)
+				{
+					row.line = y;
+
+					const Input::Pixel* const NST_RESTRICT src = input.pixels + y * WIDTH;
+
+					for (uint x=0; x < WIDTH; ++x)
+						row.rgb[x+1] = input.palette[src[x]];
+				}
+
+				return row.rgb;
+			}
+
+			template<typename T>
+			NST_FORCE_INLINE T* Renderer::FilterScaleX::Blit2xLine(T* const NST_RESTRICT dst,const dword* const NST_RESTRICT p,const dword* const NST_RESTRICT c,const dword* const NST_RESTRICT n,const long pitch)
+			{
+				for (uint x=0; x < WIDTH; x += 4)
+				{
+					const __m128i b = _mm_loadu_si128( reinterpret_cast<const __m128i*>(p+x+1) );
+					const __m128i d = _mm_loadu_si128( reinterpret_cast<const __m128i*>(c+x+0) );
+					const __m128i e = _mm_loadu_si128( reinterpret_cast<const __m128i*>(c+x+1) );
+					const __m128i f = _mm_loadu_si128( reinterpret_cast<const __m128i*>(c+x+2) );
+
+					const __m128i o = ScaleXSelect( _mm_andnot_si128( _mm_cmpeq_epi32( b, d ), _mm_cmpeq_epi32( b, f ) ), b, e );
+
+					ScaleXStore2( dst + x*2, _mm_unpacklo_epi32( e, o ), _mm_unpackhi_epi32( e, o ) );
+				}
+
+				dst[0] = dst[1] = (p[1] != n[1] && c[2] != c[1] && c[2] == p[1]) ? p[1] : c[1];
+				dst[WIDTH*2-2] = (p[WIDTH] != n[WIDTH] && c[WIDTH-1] != c[WIDTH] && c[WIDTH-1] == p[WIDTH]) ? p[WIDTH] : c[WIDTH];
+				dst[WIDTH*2-1] = c[WIDTH];
+
+				return reinterpret_cast<T*>(reinterpret_cast<byte*>(dst) + pitch);
+			}
+
+			template<typename T>
+			NST_FORCE_INLINE T* Renderer::FilterScaleX::Blit3xLine(T* const NST_RESTRICT dst,const dword* const NST_RESTRICT p,const dword* const NST_RESTRICT c,const dword* const NST_RESTRICT n,const long pitch)
+			{
+				for (uint x=0; x < WIDTH; x += 4)
+				{
+					const __m128i b = _mm_loadu_si128( reinterpret_cast<const __m128i*>(p+x+1) );
+					const __m128i h = _mm_loadu_si128( reinterpret_cast<const __m128i*>(n+x+1) );
+					const __m128i d = _mm_loadu_si128( reinterpret_cast<const __m128i*>(c+x+0) );
+					const __m128i e = _mm_loadu_si128( reinterpret_cast<const __m128i*>(c+x+1) );
+					const __m128i f = _mm_loadu_si128( reinterpret_cast<const __m128i*>(c+x+2) );
+
+					const __m128i bh = _mm_cmpeq_epi32( b, h );
+					const __m128i bd = _mm_cmpeq_epi32( b, d );
+					const __m128i bf = _mm_cmpeq_epi32( b, f );
+
+					ScaleXStore3x
+					(
+						dst + x*3,
+						ScaleXSelect( _mm_andnot_si128( _mm_or_si128( bh, bf ), bd ), b, e ),
+						e,
+						ScaleXSelect( _mm_andnot_si128( _mm_or_si128( bh, bd ), bf ), b, e )
+					);
+				}
+
+				dst[0] = c[1];
+				dst[2] = (p[1] != c[2] && p[1] != n[1]) ? p[1] : c[1];
+				dst[WIDTH*3-3] = (p[WIDTH] == c[WIDTH-1] && p[WIDTH] != n[WIDTH]) ? p[WIDTH] : c[WIDTH];
+				dst[WIDTH*3-1] = c[WIDTH];
+
+				return reinterpret_cast<T*>(reinterpret_cast<byte*>(dst) + pitch);
+			}
+
+			template<typename T>
+			NST_FORCE_INLINE T* Renderer::FilterScaleX::Blit3xCenter(T* const NST_RESTRICT dst,const dword* const NST_RESTRICT c,const long pitch)
+			{
+				for (uint x=0; x < WIDTH; x += 4)
+				{
+					const __m128i e = _mm_loadu_si128( reinterpret_cast<const __m128i*>(c+x+1) );
+					ScaleXStore3x( dst + x*3, e, e, e );
+				}
+
+				return reinterpret_cast<T*>(reinterpret_cast<byte*>(dst) + pitch);
+			}
+
+			template<typename T>
+			void Renderer::FilterScaleX::Blit2x(const Input& input,const Output& output,const uint first,const uint last)
+			{
+				Row rows[3];
+
+				for (uint i=0; i < 3; ++i)
+				{
+					rows[i].rgb[0] = rows[i].rgb[WIDTH+1] = 0;
+					rows[i].line = ~0U;
+				}
+
+				T* dst = reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + long(first) * 2 * output.pitch);
+
+				for (uint y=first; y != last; ++y)
+				{
+					const dword* const c = GetRow( rows, input, y );
+					const dword* const u = GetRow( rows, input, y ? y-1 : y );
+					const dword* const d = GetRow( rows, input, y != HEIGHT-1 ? y+1 : y );
+
+					dst = Blit2xLine<T>( dst, u, c, d, output.pitch );
+					dst = Blit2xLine<T>( dst, d, c, u, output.pitch );
+				}
+			}
+
+			template<typename T>
+			void Renderer::FilterScaleX::Blit3x(const Input& input,const Output& output,const uint first,const uint last)
 			{
-				path( input, output );
+				Row rows[3];
+
+				for (uint i=0; i < 3; ++i)
+				{
+					rows[i].rgb[0] = rows[i].rgb[WIDTH+1] = 0;
+					rows[i].line = ~0U;
+				}
+
+				T* dst = reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + long(first) * 3 * output.pitch);
+
+				for (uint y=first; y != last; ++y)
+				{
+					const dword* const c = GetRow( rows, input, y );
+					const dword* const u = GetRow( rows, input, y ? y-1 : y );
+					const dword* const d = GetRow( rows, input, y != HEIGHT-1 ? y+1 : y );
+
+					dst = Blit3xLine<T>( dst, u, c, d, output.pitch );
+					dst = Blit3xCenter<T>( dst, c, output.pitch );
+					dst = Blit3xLine<T>( dst, d, c, u, output.pitch );
+				}
 			}
 
+		#else
+
 			template<typename T,int PREV,int NEXT>
 			NST_FORCE_INLINE T* Renderer::FilterScaleX::Blit2xBorder(T* NST_RESTRICT dst,const Input::Pixel* NST_RESTRICT src,const Input::Palette& palette)
 			{
@@ -196,35 +391,43 @@ namespace Nes
 			}
 
 			template<typename T>
-			void Renderer::FilterScaleX::Blit2x(const Input& input,const Output& output)
+			void Renderer::FilterScaleX::Blit2x(const Input& input,const Output& output,const uint first,const uint last)
 			{
-				const Input::Pixel* src = input.pixels;
-				T* dst = static_cast<T*>(output.pixels);
+				const Input::Pixel* src = input.pixels + first * WIDTH;
+				T* dst = reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + long(first) * 2 * output.pitch);
 				const long pad = output.pitch - long(sizeof(T) * WIDTH*2);
 
-				dst = Blit2xLine<T,0,WIDTH>( dst, src, input.palette, pad );
-
-				for (uint y=HEIGHT-2; y; --y)
-					dst = Blit2xLine<T,-WIDTH,WIDTH>( dst, src += WIDTH, input.palette, pad );
-
-				Blit2xLine<T,-WIDTH,0>( dst, src + WIDTH, input.palette, pad );
+				for (uint y=first; y != last; ++y, src += WIDTH)
+				{
+					if (y == 0)
+						dst = Blit2xLine<T,0,WIDTH>( dst, src, input.palette, pad );
+					else if (y != HEIGHT-1)
+						dst = Blit2xLine<T,-WIDTH,WIDTH>( dst, src, input.palette, pad );
+					else
+						dst = Blit2xLine<T,-WIDTH,0>( dst, src, input.palette, pad );
+				}
 			}
 
 			template<typename T>
-			void Renderer::FilterScaleX::Blit3x(const Input& input,const Output& output)
+			void Renderer::FilterScaleX::Blit3x(const Input& input,const Output& output,const uint first,const uint last)
 			{
-				const Input::Pixel* src = input.pixels;
-				T* dst = static_cast<T*>(output.pixels);
+				const Input::Pixel* src = input.pixels + first * WIDTH;
+				T* dst = reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + long(first) * 3 * output.pitch);
 				const long pad = output.pitch - long(sizeof(T) * WIDTH*3);
 
-				dst = Blit3xLine<T,0,WIDTH>( dst, src, input.palette, pad );
-
-				for (uint y=HEIGHT-2; y; --y)
-					dst = Blit3xLine<T,-WIDTH,WIDTH>( dst, src += WIDTH, input.palette, pad );
-
-				Blit3xLine<T,-WIDTH,0>( dst, src + WIDTH, input.palette, pad );
+				for (uint y=first; y != last; ++y, src += WIDTH)
+				{
+					if (y == 0)
+						dst = Blit3xLine<T,0,WIDTH>( dst, src, input.palette, pad );
+					else if (y != HEIGHT-1)
+						dst = Blit3xLine<T,-WIDTH,WIDTH>( dst, src, input.palette, pad );
+					else
+						dst = Blit3xLine<T,-WIDTH,0>( dst, src, input.palette, pad );
+				}
 			}
 
+		#endif
+
 			#ifdef NST_MSVC_OPTIMIZE
 			#pragma optimize("s", on)
 			#endif
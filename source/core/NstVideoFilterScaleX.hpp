@@ -48,11 +48,32 @@ namespace Nes
 
 				~FilterScaleX() {}
 
-				typedef void (*Path)(const Input&,const Output&);
+				typedef void (*Path)(const Input&,const Output&,uint,uint);
 
 				static Path GetPath(const RenderState&);
 
-				void Blit(const Input&,const Output&,uint);
+				void Blit(const Input&,const Output&,uint,uint,uint);
+
+			#ifdef NST_SSE2
+
+				struct Row
+				{
+					dword rgb[WIDTH+2];
+					uint line;
+				};
+
+				static const dword* GetRow(Row (&)[3],const Input&,uint);
+
+				template<typename T>
+				static NST_FORCE_INLINE T* Blit2xLine(T* NST_RESTRICT,const dword* NST_RESTRICT,const dword* NST_RESTRICT,const dword* NST_RESTRICT,long);
+
+				template<typename T>
+				static NST_FORCE_INLINE T* Blit3xLine(T* NST_RESTRICT,const dword* NST_RESTRICT,const dword* NST_RESTRICT,const dword* NST_RESTRICT,long);
+
+				template<typename T>
+				static NST_FORCE_INLINE T* Blit3xCenter(T* NST_RESTRICT,const dword* NST_RESTRICT,long);
+
+			#else
 
 				template<typename T,int PREV,int NEXT>
 				static NST_FORCE_INLINE T* Blit2xBorder(T* NST_RESTRICT,const Input::Pixel* NST_RESTRICT,const Input::Palette&);
@@ -69,11 +90,13 @@ namespace Nes
 				template<typename T,int PREV,int NEXT>
 				static NST_FORCE_INLINE T* Blit3xLine(T*,const Input::Pixel*,const Input::Palette&,long);
 
+			#endif
+
 				template<typename T>
-				static void Blit2x(const Input&,const Output&);
+				static void Blit2x(const Input&,const Output&,uint,uint);
 
 				template<typename T>
-				static void Blit3x(const Input&,const Output&);
+				static void Blit3x(const Input&,const Output&,uint,uint);
 
 				const Path path;
 			};
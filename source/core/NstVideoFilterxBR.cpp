@@ -24,6 +24,10 @@
 #include "NstVideoRenderer.hpp"
 #include "NstVideoFilterxBR.hpp"
 
+#ifdef NST_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace Nes
 {
 	namespace Core
@@ -252,56 +256,85 @@ namespace Nes
 			 * 4x filtering, with blend support
 			 */
 			template<typename T, dword R_MASK, dword R_SHIFT, dword G_MASK, dword G_SHIFT, dword B_MASK, dword B_SHIFT, bool BLEND, bool ALL, bool SOME, bool NONE>
-			void Renderer::FilterxBR::Xbr4X(const Input& input,const Output& output)
+			void Renderer::FilterxBR::Xbr4X(const Input& input,const Output& output,const uint first,const uint last)
 			{
 				#pragma region Sets up pointers to source pixels
 
-				//Gets the pixels to filter. NST_RESTRICT tells the compiler to not alias
-				//the pointer.
-				const word* NST_RESTRICT src = input.pixels;
-
 				//Size of a raster line in output
 				const long pitch = (output.pitch * 3) + output.pitch - (WIDTH*4 * sizeof(T));
 
 				//Creates a non-aliased array with four enteries. First is the destination pixels
 				//cast into the type of pointer this function has been templated to use, the others
 				//points at the start of the next three lines. 
+				byte* const NST_RESTRICT pixels = static_cast<byte*>(output.pixels) + long(first) * 4 * output.pitch;
+
 				T* NST_RESTRICT dst[4] =
 				{
-					static_cast<T*>(output.pixels),
-					reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + output.pitch),
-					reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + output.pitch * 2),
-					reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + output.pitch * 3)
+					reinterpret_cast<T*>(pixels),
+					reinterpret_cast<T*>(pixels + output.pitch),
+					reinterpret_cast<T*>(pixels + output.pitch * 2),
+					reinterpret_cast<T*>(pixels + output.pitch * 3)
 				};
 
-				//const long pad = output.pitch - long(sizeof(dword) * WIDTH);
-				const uint MAX_PIXELS = WIDTH * HEIGHT;
+				//Source rows, filled on demand
+				Row rows[5];
+
+				for (uint i=0; i < 5; ++i)
+					rows[i].line = ~0U;
 
 				#pragma endregion
 
-				for (int y=0; y < MAX_PIXELS; y += WIDTH)
+				for (uint y=first; y != last; ++y)
 				{
-					#pragma region Clamps y coords
+					#pragma region Fetches source rows
+
+					//Rows are clamped at the top and bottom edges
+					const Row& rm2 = GetRow(rows, input, y >= 2 ? y - 2 : y);
+					const Row& rm1 = GetRow(rows, input, y >= 1 ? y - 1 : y);
+					const Row& r0  = GetRow(rows, input, y);
+					const Row& r1  = GetRow(rows, input, y + 1 < HEIGHT ? y + 1 : y);
+					const Row& r2  = GetRow(rows, input, y + 2 < HEIGHT ? y + 2 : y);
 
-					int ym1 = y - WIDTH, ym2 = y - 2*WIDTH;
-					if (ym1 < 0) ym1 = y;
-					if (ym2 < 0) ym2 = y;
-					int y1 = y + WIDTH, y2 = y + 2*WIDTH;
-					if (y1 >= MAX_PIXELS) y1 = y;
-					if (y2 >= MAX_PIXELS) y2 = y;
+					//Pixels where none of the four kernels applies
+					dword solid[WIDTH];
+					Solid(rm1, r0, r1, solid);
 
 					#pragma endregion
 
 					for (int x=0; x < WIDTH; ++x, dst[0] += 4, dst[1] += 4, dst[2] += 4, dst[3] += 4)
 					{
+						#pragma region Writes out solid blocks
+
+						if (solid[x])
+						{
+							const T c = (T) r0.px[x + 2].rgb;
+
+							dst[0][0] = c;
+							dst[0][1] = c;
+							dst[0][2] = c;
+							dst[0][3] = c;
+							dst[1][0] = c;
+							dst[1][1] = c;
+							dst[1][2] = c;
+							dst[1][3] = c;
+							dst[2][0] = c;
+							dst[2][1] = c;
+							dst[2][2] = c;
+							dst[2][3] = c;
+							dst[3][0] = c;
+							dst[3][1] = c;
+							dst[3][2] = c;
+							dst[3][3] = c;
+
+							continue;
+						}
+
+						#pragma endregion
+
 						#pragma region Clamps x coords
 
-						int xm1 = x - 1, xm2 = x - 2;
-						if (xm1 < 0) xm1 = 0;
-						if (xm2 < 0) xm1 = 0;
-						int x1 = x + 1, x2 = x + 2;
-						if (x1 >= WIDTH) x1 = WIDTH - 1;
-						if (x2 >= WIDTH) x2 = WIDTH - 1;
+						//Indices into the padded rows, see Row
+						const int xm2 = x, xm1 = x ? x + 1 : 2, x0 = x + 2, x1 = x + 3, x2 = x + 4;
 
 						#pragma endregion
 
@@ -312,33 +345,33 @@ namespace Nes
 						
 						//Fetches pixels and converts to YUV
 						YUVPixel pa, pb, pc, pd, pe, pf, pg, ph, pi, a1, b1, c1, a0, d0, g0, c4, f4, i4, g5, h5, i5;
-						pa = getPixel(input.palette[src[xm1 + ym1]]);
-						pb = getPixel(input.palette[src[x + ym1]]);
-						pc = getPixel(input.palette[src[x1 + ym1]]);
+						pa = rm1.px[xm1];
+						pb = rm1.px[x0];
+						pc = rm1.px[x1];
 
-						pd = getPixel(input.palette[src[xm1 + y]]);
-						pe = e0 = e1 = e2 = e3 = e4 = e5 = e6 = e7= e8 = e9 = ea = eb = ec = ed = ee = ef = getPixel(input.palette[src[x + y]]);;
-						pf = getPixel(input.palette[src[x1 + y]]);
+						pd = r0.px[xm1];
+						pe = e0 = e1 = e2 = e3 = e4 = e5 = e6 = e7= e8 = e9 = ea = eb = ec = ed = ee = ef = r0.px[x0];;
+						pf = r0.px[x1];
 
-						pg = getPixel(input.palette[src[xm1 + y1]]);
-						ph = getPixel(input.palette[src[x + y1]]);
-						pi = getPixel(input.palette[src[x1 + y1]]);
+						pg = r1.px[xm1];
+						ph = r1.px[x0];
+						pi = r1.px[x1];
 
-						a1 = getPixel(input.palette[src[xm1 + ym2]]);
-						b1 = getPixel(input.palette[src[x + ym2]]);
-						c1 = getPixel(input.palette[src[x1 + ym2]]);
+						a1 = rm2.px[xm1];
+						b1 = rm2.px[x0];
+						c1 = rm2.px[x1];
 
-						a0 = getPixel(input.palette[src[xm2 + ym1]]);
-						d0 = getPixel(input.palette[src[xm2 + y]]);
-						g0 = getPixel(input.palette[src[xm2 + y1]]);
+						a0 = rm1.px[xm2];
+						d0 = r0.px[xm2];
+						g0 = r1.px[xm2];
 
-						c4 = getPixel(input.palette[src[x2 + ym1]]);
-						f4 = getPixel(input.palette[src[x2 + y]]);
-						i4 = getPixel(input.palette[src[x2 + y1]]);
+						c4 = rm1.px[x2];
+						f4 = r0.px[x2];
+						i4 = r1.px[x2];
 
-						g5 = getPixel(input.palette[src[xm1 + y2]]);
-						h5 = getPixel(input.palette[src[x + y2]]);
-						i5 = getPixel(input.palette[src[x1 + y2]]);
+						g5 = r2.px[xm1];
+						h5 = r2.px[x0];
+						i5 = r2.px[x1];
 
 						#pragma endregion
 
@@ -390,55 +423,77 @@ namespace Nes
 			 * 3x filtering, with blend support
 			 */
 			template<typename T, dword R_MASK, dword R_SHIFT, dword G_MASK, dword G_SHIFT, dword B_MASK, dword B_SHIFT, bool BLEND, bool ALL, bool SOME, bool NONE>
-			void Renderer::FilterxBR::Xbr3X(const Input& input,const Output& output)
+			void Renderer::FilterxBR::Xbr3X(const Input& input,const Output& output,const uint first,const uint last)
 			{
 				#pragma region Sets up pointers to source pixels
 
-				//Gets the pixels to filter. NST_RESTRICT tells the compiler to not alias
-				//the pointer.
-				const word* NST_RESTRICT src = input.pixels;
-
 				//Size of a raster line in output
 				const long pitch = (output.pitch * 2) + output.pitch - (WIDTH*3 * sizeof(T));
 
 				//Creates a non-aliased array with three enteries. First is the destination pixels
 				//cast into the type of pointer this function has been templated to use, the others
 				//points at the start of the next two lines.
+				byte* const NST_RESTRICT pixels = static_cast<byte*>(output.pixels) + long(first) * 3 * output.pitch;
+
 				T* NST_RESTRICT dst[3] =
 				{
-					static_cast<T*>(output.pixels),
-					reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + output.pitch),
-					reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + output.pitch * 2)
+					reinterpret_cast<T*>(pixels),
+					reinterpret_cast<T*>(pixels + output.pitch),
+					reinterpret_cast<T*>(pixels + output.pitch * 2)
 				};
 
-				//const long pad = output.pitch - long(sizeof(dword) * WIDTH);
-				const uint MAX_PIXELS = WIDTH * HEIGHT;
+				//Source rows, filled on demand
+				Row rows[5];
+
+				for (uint i=0; i < 5; ++i)
+					rows[i].line = ~0U;
 
 				#pragma endregion
 
-				for (int y=0; y < MAX_PIXELS; y += WIDTH)
+				for (uint y=first; y != last; ++y)
 				{
-					#pragma region Clamps y coords
+					#pragma region Fetches source rows
+
+					//Rows are clamped at the top and bottom edges
+					const Row& rm2 = GetRow(rows, input, y >= 2 ? y - 2 : y);
+					const Row& rm1 = GetRow(rows, input, y >= 1 ? y - 1 : y);
+					const Row& r0  = GetRow(rows, input, y);
+					const Row& r1  = GetRow(rows, input, y + 1 < HEIGHT ? y + 1 : y);
+					const Row& r2  = GetRow(rows, input, y + 2 < HEIGHT ? y + 2 : y);
 
-					int ym1 = y - WIDTH, ym2 = y - 2*WIDTH;
-					if (ym1 < 0) ym1 = y;
-					if (ym2 < 0) ym2 = y;
-					int y1 = y + WIDTH, y2 = y + 2*WIDTH;
-					if (y1 >= MAX_PIXELS) y1 = y;
-					if (y2 >= MAX_PIXELS) y2 = y;
+					//Pixels where none of the four kernels applies
+					dword solid[WIDTH];
+					Solid(rm1, r0, r1, solid);
 
 					#pragma endregion
 
 					for (int x=0; x < WIDTH; ++x, dst[0] += 3, dst[1] += 3, dst[2] += 3)
 					{
+						#pragma region Writes out solid blocks
+
+						if (solid[x])
+						{
+							const T c = (T) r0.px[x + 2].rgb;
+
+							dst[0][0] = c;
+							dst[0][1] = c;
+							dst[0][2] = c;
+							dst[1][0] = c;
+							dst[1][1] = c;
+							dst[1][2] = c;
+							dst[2][0] = c;
+							dst[2][1] = c;
+							dst[2][2] = c;
+
+							continue;
+						}
+
+						#pragma endregion
+
 						#pragma region Clamps x coords
 
-						int xm1 = x - 1, xm2 = x - 2;
-						if (xm1 < 0) xm1 = 0;
-						if (xm2 < 0) xm1 = 0;
-						int x1 = x + 1, x2 = x + 2;
-						if (x1 >= WIDTH) x1 = WIDTH - 1;
-						if (x2 >= WIDTH) x2 = WIDTH - 1;
+						//Indices into the padded rows, see Row
+						const int xm2 = x, xm1 = x ? x + 1 : 2, x0 = x + 2, x1 = x + 3, x2 = x + 4;
 
 						#pragma endregion
 
@@ -449,33 +504,33 @@ namespace Nes
 						
 						//Fetches pixels and converts to YUV
 						YUVPixel pa, pb, pc, pd, pe, pf, pg, ph, pi, a1, b1, c1, a0, d0, g0, c4, f4, i4, g5, h5, i5;
-						pa = getPixel(input.palette[src[xm1 + ym1]]);
-						pb = getPixel(input.palette[src[x + ym1]]);
-						pc = getPixel(input.palette[src[x1 + ym1]]);
+						pa = rm1.px[xm1];
+						pb = rm1.px[x0];
+						pc = rm1.px[x1];
 
-						pd = getPixel(input.palette[src[xm1 + y]]);
-						pe = e0 = e1 = e2 = e3 = e4 = e5 = e6 = e7= e8 = getPixel(input.palette[src[x + y]]);;
-						pf = getPixel(input.palette[src[x1 + y]]);
+						pd = r0.px[xm1];
+						pe = e0 = e1 = e2 = e3 = e4 = e5 = e6 = e7= e8 = r0.px[x0];;
+						pf = r0.px[x1];
 
-						pg = getPixel(input.palette[src[xm1 + y1]]);
-						ph = getPixel(input.palette[src[x + y1]]);
-						pi = getPixel(input.palette[src[x1 + y1]]);
+						pg = r1.px[xm1];
+						ph = r1.px[x0];
+						pi = r1.px[x1];
 
-						a1 = getPixel(input.palette[src[xm1 + ym2]]);
-						b1 = getPixel(input.palette[src[x + ym2]]);
-						c1 = getPixel(input.palette[src[x1 + ym2]]);
+						a1 = rm2.px[xm1];
+						b1 = rm2.px[x0];
+						c1 = rm2.px[x1];
 
-						a0 = getPixel(input.palette[src[xm2 + ym1]]);
-						d0 = getPixel(input.palette[src[xm2 + y]]);
-						g0 = getPixel(input.palette[src[xm2 + y1]]);
+						a0 = rm1.px[xm2];
+						d0 = r0.px[xm2];
+						g0 = r1.px[xm2];
 
-						c4 = getPixel(input.palette[src[x2 + ym1]]);
-						f4 = getPixel(input.palette[src[x2 + y]]);
-						i4 = getPixel(input.palette[src[x2 + y1]]);
+						c4 = rm1.px[x2];
+						f4 = r0.px[x2];
+						i4 = r1.px[x2];
 
-						g5 = getPixel(input.palette[src[xm1 + y2]]);
-						h5 = getPixel(input.palette[src[x + y2]]);
-						i5 = getPixel(input.palette[src[x1 + y2]]);
+						g5 = r2.px[xm1];
+						h5 = r2.px[x0];
+						i5 = r2.px[x1];
 
 						#pragma endregion
 
@@ -522,55 +577,70 @@ namespace Nes
 			 * Implements 2xBR
 			 */
 			template<typename T, dword R_MASK, dword R_SHIFT, dword G_MASK, dword G_SHIFT, dword B_MASK, dword B_SHIFT, bool BLEND, bool ALL, bool SOME, bool NONE>
-			void Renderer::FilterxBR::Xbr2X(const Input& input,const Output& output)
+			void Renderer::FilterxBR::Xbr2X(const Input& input,const Output& output,const uint first,const uint last)
 			{
 				#pragma region Sets up pointers to source pixels
 
-				//Gets the pixels to filter. NST_RESTRICT tells the compiler to not alias
-				//the pointer.
-				const word* NST_RESTRICT src = input.pixels;
-
 				//Size of a raster line in output
 				const long pitch = output.pitch;
 
 				//Creates a non-aliased array with two enteries. First is the destination pixels
 				//cast into the type of pointer this function has been templated to use, the other
 				//points at the start of the next line.
+				byte* const NST_RESTRICT pixels = static_cast<byte*>(output.pixels) + long(first) * 2 * pitch;
+
 				T* NST_RESTRICT dst[2] =
 				{
-					static_cast<T*>(output.pixels),
-					reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + pitch)
+					reinterpret_cast<T*>(pixels),
+					reinterpret_cast<T*>(pixels + pitch)
 				};
-				//const long pad = output.pitch - long(sizeof(dword) * WIDTH);
-				const uint MAX_PIXELS = WIDTH * HEIGHT;
+				//Source rows, filled on demand
+				Row rows[5];
+
+				for (uint i=0; i < 5; ++i)
+					rows[i].line = ~0U;
 
 				#pragma endregion
 
-				for (int y=0; y < MAX_PIXELS; y += WIDTH)
+				for (uint y=first; y != last; ++y)
 				{
-					#pragma region Clamps y coords
+					#pragma region Fetches source rows
 
-					//Clamps y coords
-					int ym1 = y - WIDTH, ym2 = y - 2*WIDTH;
-					if (ym1 < 0) ym1 = y;
-					if (ym2 < 0) ym2 = y;
-					int y1 = y + WIDTH, y2 = y + 2*WIDTH;
-					if (y1 >= MAX_PIXELS) y1 = y;
-					if (y2 >= MAX_PIXELS) y2 = y;
+					//Rows are clamped at the top and bottom edges
+					const Row& rm2 = GetRow(rows, input, y >= 2 ? y - 2 : y);
+					const Row& rm1 = GetRow(rows, input, y >= 1 ? y - 1 : y);
+					const Row& r0  = GetRow(rows, input, y);
+					const Row& r1  = GetRow(rows, input, y + 1 < HEIGHT ? y + 1 : y);
+					const Row& r2  = GetRow(rows, input, y + 2 < HEIGHT ? y + 2 : y);
+
+					//Pixels where none of the four kernels applies
+					dword solid[WIDTH];
+					Solid(rm1, r0, r1, solid);
 
 					#pragma endregion
 
 					for (int x=0; x < WIDTH; ++x, dst[0] += 2, dst[1] += 2)
 					{
+						#pragma region Writes out solid blocks
+
+						if (solid[x])
+						{
+							const T c = (T) r0.px[x + 2].rgb;
+
+							dst[0][0] = c;
+							dst[0][1] = c;
+							dst[1][0] = c;
+							dst[1][1] = c;
+
+							continue;
+						}
+
+						#pragma endregion
+
 						#pragma region Clamps x coords
 
-						//Clamps x coords
-						int xm1 = x - 1, xm2 = x - 2;
-						if (xm1 < 0) xm1 = 0;
-						if (xm2 < 0) xm1 = 0;
-						int x1 = x + 1, x2 = x + 2;
-						if (x1 >= WIDTH) x1 = WIDTH - 1;
-						if (x2 >= WIDTH) x2 = WIDTH - 1;
+						//Indices into the padded rows, see Row
+						const int xm2 = x, xm1 = x ? x + 1 : 2, x0 = x + 2, x1 = x + 3, x2 = x + 4;
 
 						#pragma endregion
 
@@ -581,33 +651,33 @@ namespace Nes
 						
 						//Fetches pixels and converts to YUV
 						YUVPixel pa, pb, pc, pd, pe, pf, pg, ph, pi, a1, b1, c1, a0, d0, g0, c4, f4, i4, g5, h5, i5;
-						pa = getPixel(input.palette[src[xm1 + ym1]]);
-						pb = getPixel(input.palette[src[x + ym1]]);
-						pc = getPixel(input.palette[src[x1 + ym1]]);
+						pa = rm1.px[xm1];
+						pb = rm1.px[x0];
+						pc = rm1.px[x1];
 
-						pd = getPixel(input.palette[src[xm1 + y]]);
-						pe = e0 = e1 = e2 = e3 = getPixel(input.palette[src[x + y]]);;
-						pf = getPixel(input.palette[src[x1 + y]]);
+						pd = r0.px[xm1];
+						pe = e0 = e1 = e2 = e3 = r0.px[x0];;
+						pf = r0.px[x1];
 
-						pg = getPixel(input.palette[src[xm1 + y1]]);
-						ph = getPixel(input.palette[src[x + y1]]);
-						pi = getPixel(input.palette[src[x1 + y1]]);
+						pg = r1.px[xm1];
+						ph = r1.px[x0];
+						pi = r1.px[x1];
 
-						a1 = getPixel(input.palette[src[xm1 + ym2]]);
-						b1 = getPixel(input.palette[src[x + ym2]]);
-						c1 = getPixel(input.palette[src[x1 + ym2]]);
+						a1 = rm2.px[xm1];
+						b1 = rm2.px[x0];
+						c1 = rm2.px[x1];
 
-						a0 = getPixel(input.palette[src[xm2 + ym1]]);
-						d0 = getPixel(input.palette[src[xm2 + y]]);
-						g0 = getPixel(input.palette[src[xm2 + y1]]);
+						a0 = rm1.px[xm2];
+						d0 = r0.px[xm2];
+						g0 = r1.px[xm2];
 
-						c4 = getPixel(input.palette[src[x2 + ym1]]);
-						f4 = getPixel(input.palette[src[x2 + y]]);
-						i4 = getPixel(input.palette[src[x2 + y1]]);
+						c4 = rm1.px[x2];
+						f4 = r0.px[x2];
+						i4 = r1.px[x2];
 
-						g5 = getPixel(input.palette[src[xm1 + y2]]);
-						h5 = getPixel(input.palette[src[x + y2]]);
-						i5 = getPixel(input.palette[src[x1 + y2]]);
+						g5 = r2.px[xm1];
+						h5 = r2.px[x0];
+						i5 = r2.px[x1];
 
 						#pragma endregion
 
@@ -639,9 +709,89 @@ namespace Nes
 				}
 			}
 
-			void Renderer::FilterxBR::Blit(const Input& input,const Output& output,uint)
+			/**
+			 * Returns a source row, converting it if its slot holds another line.
+			 *
+			 * Any five consecutive lines use different slots.
+			 */
+			const Renderer::FilterxBR::Row& Renderer::FilterxBR::GetRow(Row (&rows)[5], const Input& input, const uint line) const
+			{
+				Row& row = rows[line % 5];
+
+				if (row.line != line)
+				{
+					const word* const NST_RESTRICT src = input.pixels + line * WIDTH;
+
+					row.line = line;
+
+					for (int x=-2; x < int(WIDTH); ++x)
+						row.px[x + 2] = getPixel(input.palette[src[x]]);
+
+					row.px[WIDTH + 2] = row.px[WIDTH + 3] = row.px[WIDTH + 1];
+
+					for (uint x=0; x < WIDTH; ++x)
+						row.rgb[x + 1] = row.px[x + 2].rgb;
+
+					row.rgb[0] = row.rgb[1];
+					row.rgb[WIDTH + 1] = row.rgb[WIDTH];
+				}
+
+				return row;
+			}
+
+		#ifdef NST_SSE2
+
+			/**
+			 * Flags the pixels equal to enough of their neighbours that every
+			 * kernel returns early, four at a time.
+			 */
+			void Renderer::FilterxBR::Solid(const Row& above, const Row& line, const Row& below, dword* const NST_RESTRICT dst)
+			{
+				for (uint x=0; x < WIDTH; x += 4)
+				{
+					const __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(line.rgb + x + 1));
+					const __m128i b = _mm_cmpeq_epi32(e, _mm_loadu_si128(reinterpret_cast<const __m128i*>(above.rgb + x + 1)));
+					const __m128i d = _mm_cmpeq_epi32(e, _mm_loadu_si128(reinterpret_cast<const __m128i*>(line.rgb + x)));
+					const __m128i f = _mm_cmpeq_epi32(e, _mm_loadu_si128(reinterpret_cast<const __m128i*>(line.rgb + x + 2)));
+					const __m128i h = _mm_cmpeq_epi32(e, _mm_loadu_si128(reinterpret_cast<const __m128i*>(below.rgb + x + 1)));
+
+					_mm_storeu_si128
+					(
+						reinterpret_cast<__m128i*>(dst + x),
+						_mm_and_si128
+						(
+							_mm_and_si128(_mm_or_si128(h, f), _mm_or_si128(f, b)),
+							_mm_and_si128(_mm_or_si128(b, d), _mm_or_si128(d, h))
+						)
+					);
+				}
+			}
+
+		#else
+
+			/**
+			 * Flags the pixels equal to enough of their neighbours that every
+			 * kernel returns early.
+			 */
+			void Renderer::FilterxBR::Solid(const Row& above, const Row& line, const Row& below, dword* const NST_RESTRICT dst)
+			{
+				for (uint x=0; x < WIDTH; ++x)
+				{
+					const dword e = line.rgb[x + 1];
+					const bool b = (e == above.rgb[x + 1]);
+					const bool d = (e == line.rgb[x]);
+					const bool f = (e == line.rgb[x + 2]);
+					const bool h = (e == below.rgb[x + 1]);
+
+					dst[x] = ((h || f) && (f || b) && (b || d) && (d || h));
+				}
+			}
+
+		#endif
+
+			void Renderer::FilterxBR::Blit(const Input& input,const Output& output,uint,uint first,uint last)
 			{
-				(*this.*path)( input, output );
+				(*this.*path)( input, output, first, last );
 			}
 
 			#pragma region Kernels
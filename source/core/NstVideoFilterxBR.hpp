@@ -50,20 +50,20 @@ namespace Nes
 				void freeCache() const;
 				void initCache() const;
 
-				typedef void (FilterxBR::*Path)(const Input&,const Output&);
+				typedef void (FilterxBR::*Path)(const Input&,const Output&,uint,uint);
 				static Path GetPath(const RenderState&, const bool blend, const schar corner_rounding);
 
-				void Blit(const Input&,const Output&,uint);
+				void Blit(const Input&,const Output&,uint,uint,uint);
 				void Transform(const byte (&)[PALETTE][3],Input::Palette&) const;
 
 				template<typename T, dword R_MASK, dword R_SHIFT, dword G_MASK, dword G_SHIFT, dword B_MASK, dword B_SHIFT, bool BLEND, bool ALL, bool SOME, bool NONE>
-					void Xbr4X(const Input&,const Output&);
+					void Xbr4X(const Input&,const Output&,uint,uint);
 
 				template<typename T, dword R_MASK, dword R_SHIFT, dword G_MASK, dword G_SHIFT, dword B_MASK, dword B_SHIFT, bool BLEND, bool ALL, bool SOME, bool NONE>
-					void Xbr3X(const Input&,const Output&);
+					void Xbr3X(const Input&,const Output&,uint,uint);
 
 				template<typename T, dword R_MASK, dword R_SHIFT, dword G_MASK, dword G_SHIFT, dword B_MASK, dword B_SHIFT, bool BLEND, bool ALL, bool SOME, bool NONE> 
-					void Xbr2X(const Input&,const Output&);
+					void Xbr2X(const Input&,const Output&,uint,uint);
 
 				template<dword R_MASK, dword R_SHIFT, dword G_MASK, dword G_SHIFT, dword B_MASK, dword B_SHIFT, bool BLEND, bool ALL, bool SOME, bool NONE>
 				inline void Kernel2X(YUVPixel pe, YUVPixel pi, YUVPixel ph, YUVPixel pf, YUVPixel pg, 
@@ -136,6 +136,21 @@ namespace Nes
 
 				inline YUVPixel& getPixel(dword col) const;
 
+				//A source line converted to YUV pixels. The kernels read two columns
+				//past each edge: "px" holds columns -2 to WIDTH+1, where -2 and -1 are
+				//the two values stored just before the line and the right edge repeats
+				//the last column. "rgb" holds columns -1 to WIDTH clamped at both edges,
+				//for the solid block test.
+				struct Row
+				{
+					YUVPixel px[WIDTH+4];
+					dword rgb[WIDTH+2];
+					uint line;
+				};
+
+				const Row& GetRow(Row (&)[5], const Input&, uint) const;
+				static void Solid(const Row&, const Row&, const Row&, dword*);
+
 				//YUV cache. It works like this:
 				//There's a 32KB lookup table where each index corresponds with a 15-bit
 				//RGB color. This means one can convert a RGB color to YUV by making a
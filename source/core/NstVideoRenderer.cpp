@@ -509,7 +509,7 @@ namespace Nes
 			}
 
 			Renderer::Filter::Filter(const RenderState& state)
-			: format(state) {}
+			: format(state), dirty(NULL) {}
 
 			void Renderer::Filter::Transform(const byte (&src)[PALETTE][3],Input::Palette& dst) const
 			{
@@ -529,8 +529,10 @@ namespace Nes
 			width        (0),
 			height       (0),
 			filter       (RenderState::FILTER_NONE),
+			threads      (1),
 			update       (UPDATE_PALETTE),
 			fieldMerging (0),
+			ntscRowCache (0),
 			brightness   (0),
 			saturation   (0),
 			hue          (0),
@@ -548,6 +550,21 @@ namespace Nes
 				mask.b = 0;
 			}
 
+			Renderer::History::History()
+			: pixels(NULL), valid(false) {}
+
+			Renderer::History::~History()
+			{
+				delete [] pixels;
+			}
+
+			Renderer::FrameHash::FrameHash()
+			: enabled(false), valid(false)
+			{
+				value[0] = 0;
+				value[1] = 0;
+			}
+
 			Renderer::Renderer()
 			: filter(NULL) {}
 
@@ -558,6 +575,11 @@ namespace Nes
 
 			Result Renderer::SetState(const RenderState& renderState)
 			{
+				const uint threads = NST_MAX(1,NST_MIN(renderState.threads,uint(State::MAX_THREADS)));
+				const bool rethread = (state.threads != threads);
+
+				state.threads = threads;
+
 				if (filter)
 				{
 					if
@@ -570,7 +592,7 @@ namespace Nes
 						state.mask.g == renderState.bits.mask.g &&
 						state.mask.b == renderState.bits.mask.b
 					)
-						return RESULT_NOP;
+						return rethread ? RESULT_OK : RESULT_NOP;
 
 					delete filter;
 					filter = NULL;
@@ -634,7 +656,8 @@ namespace Nes
 									state.bleed,
 									state.artifacts,
 									state.fringing,
-									state.fieldMerging
+									state.fieldMerging,
+									state.ntscRowCache
 								);
 							}
 							break;
@@ -666,6 +689,8 @@ namespace Nes
 					state.height = renderState.height;
 					state.mask = renderState.bits.mask;
 
+					history.valid = false;
+
 					if (state.filter == RenderState::FILTER_NTSC)
 						state.update = 0;
 					else
@@ -688,6 +713,7 @@ namespace Nes
 					output.height = state.height;
 					output.bits.count = filter->format.bpp;
 					output.bits.mask = state.mask;
+					output.threads = state.threads;
 
 					return RESULT_OK;
 				}
@@ -719,6 +745,49 @@ namespace Nes
 					state.update |= uint(State::UPDATE_NTSC);
 			}
 
+			void Renderer::EnableNtscRowCache(bool enable)
+			{
+				if (bool(state.ntscRowCache) != enable)
+				{
+					state.ntscRowCache = enable;
+					state.update |= uint(State::UPDATE_NTSC);
+				}
+			}
+
+			Result Renderer::EnablePersistentOutput(bool enable)
+			{
+				if (bool(history.pixels) == enable)
+					return RESULT_NOP;
+
+				history.valid = false;
+
+				if (enable)
+				{
+					history.pixels = new (std::nothrow) Input::Pixel [PIXELS];
+
+					if (!history.pixels)
+						return RESULT_ERR_OUT_OF_MEMORY;
+				}
+				else
+				{
+					delete [] history.pixels;
+					history.pixels = NULL;
+				}
+
+				return RESULT_OK;
+			}
+
+			Result Renderer::EnableFrameHash(bool enable)
+			{
+				if (frameHash.enabled == enable)
+					return RESULT_NOP;
+
+				frameHash.enabled = enable;
+				frameHash.valid = false;
+
+				return RESULT_OK;
+			}
+
 			Result Renderer::SetHue(int hue)
 			{
 				if (hue < -45 || hue > 45)
@@ -814,29 +883,157 @@ namespace Nes
 				}
 
 				state.update = 0;
+				history.valid = false;
 			}
 
 			#ifdef NST_MSVC_OPTIMIZE
 			#pragma optimize("", on)
 			#endif
 
-			void Renderer::Blit(Output& output,Input& input,uint burstPhase)
+			inline qaword Renderer::FrameHash::Mix(qaword h,qaword k)
+			{
+				k *= qaword(0x87C37B91UL) << 32 | 0x114253D5UL;
+				k = k << 31 | k >> 33;
+				k *= qaword(0x4CF5AD43UL) << 32 | 0x2745937FUL;
+
+				h ^= k;
+				h = h << 27 | h >> 37;
+
+				return h * 5 + 0x52DCE729UL;
+			}
+
+			void Renderer::FrameHash::Update(const Input& input,const uint phase,const uint background)
+			{
+				qaword h = phase | qaword(background) << 32;
+
+				for (const Input::Pixel* NST_RESTRICT src=input.pixels, *const end=src+PIXELS; src != end; src += 4)
+					h = Mix( h, (src[0] | dword(src[1]) << 16) | qaword(src[2] | dword(src[3]) << 16) << 32 );
+
+				for (const dword* NST_RESTRICT src=input.palette, *const end=src+PALETTE; src != end; src += 2)
+					h = Mix( h, src[0] | qaword(src[1]) << 32 );
+
+				h ^= h >> 33;
+				h *= qaword(0xFF51AFD7UL) << 32 | 0xED558CCDUL;
+				h ^= h >> 33;
+				h *= qaword(0xC4CEB9FEUL) << 32 | 0x1A85EC53UL;
+				h ^= h >> 33;
+
+				value[0] = dword(h & 0xFFFFFFFFUL);
+				value[1] = dword(h >> 32);
+				valid = true;
+			}
+
+			uint Renderer::GetPhase(const uint burstPhase) const
+			{
+				return (state.filter == RenderState::FILTER_NTSC && !state.fieldMerging) ? burstPhase : 0;
+			}
+
+			void Renderer::UpdateFrameHash(Input& input,const uint burstPhase)
+			{
+				if (frameHash.enabled)
+				{
+					if (filter && state.update)
+						UpdateFilter( input );
+
+					frameHash.Update( input, GetPhase(burstPhase), bgColor );
+				}
+			}
+
+			uint Renderer::History::Update(const Input& input,const Output& output,const uint burstPhase,const uint background)
+			{
+				if (!valid || target != output.pixels || pitch != output.pitch || phase != burstPhase || bgColor != background)
+				{
+					valid = true;
+					target = output.pixels;
+					pitch = output.pitch;
+					phase = burstPhase;
+					bgColor = background;
+
+					std::memcpy( pixels, input.pixels, PIXELS * sizeof(Input::Pixel) );
+
+					return HEIGHT;
+				}
+
+				uint count = 0;
+
+				for (uint y=0; y < HEIGHT; ++y)
+				{
+					const Input::Pixel* const src = input.pixels + y * WIDTH;
+					Input::Pixel* const dst = pixels + y * WIDTH;
+
+					dirty[y] = std::memcmp( dst, src, WIDTH * sizeof(Input::Pixel) ) != 0;
+
+					if (dirty[y])
+					{
+						std::memcpy( dst, src, WIDTH * sizeof(Input::Pixel) );
+						++count;
+					}
+				}
+
+				return count;
+			}
+
+			struct Renderer::Band
+			{
+				Filter* const filter;
+				const Input& input;
+				const Output& output;
+				const uint phase;
+				const uint count;
+			};
+
+			void NST_CALLBACK Renderer::BlitBand(void* context,const uint index)
+			{
+				const Band& band = *static_cast<const Band*>(context);
+				band.filter->Blit( band.input, band.output, band.phase, HEIGHT * index / band.count, HEIGHT * (index + 1) / band.count );
+			}
+
+			void Renderer::BlitFilter(const Output& output,const Input& input,const uint burstPhase,const UserCallbacks& callbacks)
+			{
+				if (state.threads > 1)
+				{
+					Band band = { filter, input, output, burstPhase, state.threads };
+					callbacks[Output::dispatchCallback]( &BlitBand, &band, state.threads );
+				}
+				else
+				{
+					filter->Blit( input, output, burstPhase, 0, HEIGHT );
+				}
+			}
+
+			void Renderer::Blit(Output& output,Input& input,uint burstPhase,const UserCallbacks& callbacks)
 			{
 				if (filter)
 				{
 					if (state.update)
 						UpdateFilter( input );
 
-					if (Output::lockCallback( output ))
+					if (callbacks[Output::lockCallback]( output ))
 					{
 						NST_VERIFY( std::labs(output.pitch) >= dword(state.width) << (filter->format.bpp / 16) );
 						
 						filter->bgColor = bgColor;
 
 						if (std::labs(output.pitch) >= dword(state.width) << (filter->format.bpp / 16))
-							filter->Blit( input, output, burstPhase );
+						{
+							if (history.pixels)
+							{
+								const uint lines = history.Update( input, output, GetPhase(burstPhase), bgColor );
+
+								if (lines)
+								{
+									filter->dirty = (lines != HEIGHT ? history.dirty : NULL);
+									BlitFilter( output, input, burstPhase, callbacks );
+									filter->dirty = NULL;
+								}
+							}
+							else
+							{
+								BlitFilter( output, input, burstPhase, callbacks );
+							}
+						}
 
-						Output::unlockCallback( output );
+						callbacks[Output::unlockCallback]( output );
 					}
 				}
 			}
@@ -73,7 +73,7 @@ namespace Nes
 				Result SetState(const RenderState&);
 				Result GetState(RenderState&) const;
 				Result SetHue(int);
-				void Blit(Output&,Input&,uint);
+				void Blit(Output&,Input&,uint,const UserCallbacks&);
 
 				Result SetDecoder(const Decoder&);
 
@@ -83,6 +83,11 @@ namespace Nes
 
 				void EnableFieldMerging(bool);
 				void EnableForcedFieldMerging(bool);
+				void EnableNtscRowCache(bool);
+
+				Result EnablePersistentOutput(bool);
+				Result EnableFrameHash(bool);
+				void UpdateFrameHash(Input&,uint);
 
 				typedef byte PaletteEntries[PALETTE][3];
 
@@ -90,7 +95,13 @@ namespace Nes
 
 			private:
 
+				struct Band;
+
 				void UpdateFilter(Input&);
+				uint GetPhase(uint) const;
+				void BlitFilter(const Output&,const Input&,uint,const UserCallbacks&);
+
+				static void NST_CALLBACK BlitBand(void*,uint);
 
 				class Palette
 				{
@@ -198,12 +209,13 @@ namespace Nes
 
 					virtual ~Filter() {}
 
-					virtual void Blit(const Input&,const Output&,uint) = 0;
+					virtual void Blit(const Input&,const Output&,uint,uint,uint) = 0;
 					virtual void Transform(const byte (&)[PALETTE][3],Input::Palette&) const;
 
 					const Format format;
 					
 					uint bgColor;
+					const byte* dirty;
 				};
 
 				struct State
@@ -212,6 +224,7 @@ namespace Nes
 
 					enum
 					{
+						MAX_THREADS = 32,
 						UPDATE_PALETTE = 0x1,
 						UPDATE_FILTER = 0x2,
 						UPDATE_NTSC = 0x4,
@@ -223,8 +236,10 @@ namespace Nes
 					word width;
 					word height;
 					byte filter;
+					byte threads;
 					byte update;
 					byte fieldMerging;
+					byte ntscRowCache;
 					schar brightness;
 					schar saturation;
 					schar hue;
@@ -239,11 +254,42 @@ namespace Nes
 					RenderState::Bits::Mask mask;
 				};
 
+				struct History
+				{
+					History();
+					~History();
+
+					uint Update(const Input&,const Output&,uint,uint);
+
+					Input::Pixel* pixels;
+					const void* target;
+					long pitch;
+					uint phase;
+					uint bgColor;
+					bool valid;
+					byte dirty[HEIGHT];
+				};
+
+				struct FrameHash
+				{
+					FrameHash();
+
+					void Update(const Input&,uint,uint);
+
+					static inline qaword Mix(qaword,qaword);
+
+					bool enabled;
+					bool valid;
+					dword value[2];
+				};
+
 				Result SetLevel(schar&,int,uint=State::UPDATE_PALETTE|State::UPDATE_FILTER);
 
 				Filter* filter;
 				State state;
 				Palette palette;
+				History history;
+				FrameHash frameHash;
 
 			public:
 
@@ -363,11 +409,37 @@ namespace Nes
 					return state.hue;
 				}
 
+				bool IsPersistentOutputEnabled() const
+				{
+					return history.pixels;
+				}
+
+				bool IsFrameHashEnabled() const
+				{
+					return frameHash.enabled;
+				}
+
+				Result GetFrameHash(dword (&hash)[2]) const
+				{
+					if (!frameHash.valid)
+						return RESULT_ERR_NOT_READY;
+
+					hash[0] = frameHash.value[0];
+					hash[1] = frameHash.value[1];
+
+					return RESULT_OK;
+				}
+
 				bool IsFieldMergingEnabled() const
 				{
 					return state.fieldMerging & uint(State::FIELD_MERGING_USER);
 				}
 
+				bool IsNtscRowCacheEnabled() const
+				{
+					return state.ntscRowCache;
+				}
+
 				PaletteType GetPaletteType() const
 				{
 					return palette.GetType();
@@ -89,6 +89,130 @@ namespace Nes
 				return !function;
 			}
 		};
+
+		/**
+		* Per-instance callback table.
+		*
+		* Holds the callbacks of a single emulator instance. Entries are keyed
+		* by the static callback manager they stand in for, which remains the
+		* process-wide default for instances that have no entry of their own.
+		*/
+		class UserCallbacks
+		{
+			typedef void (*Function)();
+
+			struct Entry
+			{
+				const void* key;
+				Function function;
+				void* userdata;
+			};
+
+			enum
+			{
+				MAX_ENTRIES = 64
+			};
+
+			Entry entries[MAX_ENTRIES];
+			unsigned int size;
+
+			const Entry* Find(const void* key) const
+			{
+				for (unsigned int i=0; i < size; ++i)
+				{
+					if (entries[i].key == key)
+						return entries+i;
+				}
+
+				return 0;
+			}
+
+			void Insert(const void* key,Function function,void* userdata)
+			{
+				Entry* entry = const_cast<Entry*>(Find( key ));
+
+				if (!entry)
+				{
+					if (size == MAX_ENTRIES)
+						return;
+
+					entry = entries + size++;
+					entry->key = key;
+				}
+
+				entry->function = function;
+				entry->userdata = userdata;
+			}
+
+			void Remove(const void* key)
+			{
+				if (const Entry* const entry = Find( key ))
+					entries[entry - entries] = entries[--size];
+			}
+
+		public:
+
+			UserCallbacks()
+			: size(0) {}
+
+			/**
+			* Overrides a callback for this instance only.
+			*
+			* A NULL function is a valid override and silences the
+			* callback regardless of the process-wide default.
+			*
+			* @param global static callback manager
+			* @param function callback function
+			* @param userdata optional user data
+			*/
+			template<typename T>
+			void Set(const T& global,typename T::Function function,void* userdata)
+			{
+				Insert( &global, reinterpret_cast<Function>(function), userdata );
+			}
+
+			/**
+			* Removes an override, reverting to the process-wide default.
+			*
+			* @param global static callback manager
+			*/
+			template<typename T>
+			void Unset(const T& global)
+			{
+				Remove( &global );
+			}
+
+			/**
+			* Checks if a callback is overridden for this instance.
+			*
+			* @param global static callback manager
+			* @return true if overridden
+			*/
+			template<typename T>
+			bool IsSet(const T& global) const
+			{
+				return Find( &global ) != 0;
+			}
+
+			/**
+			* Returns the callback in effect for this instance.
+			*
+			* @param global static callback manager
+			* @return callback invoker
+			*/
+			template<typename T>
+			T operator [] (const T& global) const
+			{
+				if (const Entry* const entry = Find( &global ))
+				{
+					T caller;
+					caller.Set( reinterpret_cast<typename T::Function>(entry->function), entry->userdata );
+					return caller;
+				}
+
+				return global;
+			}
+		};
 	}
 
 	namespace Api
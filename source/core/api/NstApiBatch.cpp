@@ -0,0 +1,252 @@
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// Nestopia - NES/Famicom emulator written in C++
+//
+// Copyright (C) 2003-2008 Martin Freij
+//
+// This file is part of Nestopia.
+//
+// Nestopia is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Nestopia is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Nestopia; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <new>
+#include "../NstMachine.hpp"
+#include "NstApiEmulator.hpp"
+#include "NstApiVideo.hpp"
+#include "NstApiSound.hpp"
+#include "NstApiInput.hpp"
+#include "NstApiBatch.hpp"
+
+namespace Nes
+{
+	namespace Api
+	{
+		struct Batch::Slot
+		{
+			Slot()
+			: result(RESULT_NOP), pitch(0), length(0), sampleSize(0), phase(0) {}
+
+			Result result;
+			long pitch;
+			uint length;
+			uint sampleSize;
+			dword phase;
+		};
+
+		#ifdef NST_MSVC_OPTIMIZE
+		#pragma optimize("s", on)
+		#endif
+
+		Batch::DispatchCaller Batch::dispatchCallback;
+
+		Batch::Buffer::Buffer()
+		: data(NULL), stride(0), capacity(0) {}
+
+		Batch::Buffer::~Buffer()
+		{
+			delete [] data;
+		}
+
+		bool Batch::Buffer::Reserve(uint count,ulong size)
+		{
+			if (capacity < count * size)
+			{
+				uchar* const next = new (std::nothrow) uchar [count * size];
+
+				if (next == NULL)
+					return false;
+
+				delete [] data;
+				data = next;
+				capacity = count * size;
+			}
+
+			stride = size;
+
+			return true;
+		}
+
+		Batch::Batch(Emulator* const* e,uint n) throw()
+		:
+		emulators (e),
+		count     (e ? n : 0),
+		slots     (NULL),
+		input     (NULL),
+		frames    (0),
+		output    (0)
+		{
+		}
+
+		Batch::~Batch() throw()
+		{
+			delete [] slots;
+		}
+
+		Result Batch::Reserve()
+		{
+			if (slots == NULL && NULL == (slots = new (std::nothrow) Slot [count]))
+				return RESULT_ERR_OUT_OF_MEMORY;
+
+			ulong videoSize = 0, soundSize = 0;
+
+			for (uint i=0; i < count; ++i)
+			{
+				Slot& slot = slots[i];
+
+				if (output & OUTPUT_VIDEO)
+				{
+					Video::RenderState state;
+
+					if (NES_FAILED(Video(*emulators[i]).GetRenderState( state )))
+						return RESULT_ERR_NOT_READY;
+
+					slot.pitch = long(state.width) * (state.bits.count / 8);
+					videoSize = NST_MAX( videoSize, ulong(slot.pitch) * state.height );
+				}
+
+				if (output & OUTPUT_SOUND)
+				{
+					Core::Machine& machine = *emulators[i];
+					const Core::Apu& apu = machine.cpu.GetApu();
+					const dword speed = apu.GetSpeed() ? apu.GetSpeed() : machine.cpu.GetFps();
+
+					slot.sampleSize = apu.GetSampleBits() / 8 * (apu.InStereo() ? 2 : 1);
+					soundSize = NST_MAX( soundSize, ulong((apu.GetSampleRate() + speed - 1) / speed) * frames * slot.sampleSize );
+				}
+			}
+
+			if
+			(
+				!video.Reserve( count, videoSize ) ||
+				!sound.Reserve( count, soundSize ) ||
+				!ram.Reserve( count, (output & OUTPUT_RAM) ? RAM_SIZE : 0 )
+			)
+				return RESULT_ERR_OUT_OF_MEMORY;
+
+			return RESULT_OK;
+		}
+
+		#ifdef NST_MSVC_OPTIMIZE
+		#pragma optimize("", on)
+		#endif
+
+		void NST_CALLBACK Batch::Step(void* context,const uint index)
+		{
+			const Batch& batch = *static_cast<const Batch*>(context);
+			Slot& slot = batch.slots[index];
+			Emulator& emulator = *batch.emulators[index];
+			Core::Machine& machine = emulator;
+
+			Core::Video::Output video( batch.video.data + batch.video.stride * index, slot.pitch );
+			Core::Sound::Output sound;
+			uchar* const samples = batch.sound.data + batch.sound.stride * index;
+			Core::Input::Controllers* const input = batch.input ? batch.input + index : NULL;
+
+			slot.result = RESULT_OK;
+			slot.length = 0;
+
+			for (uint frame=batch.frames; frame; --frame)
+			{
+				if (batch.output & OUTPUT_SOUND)
+				{
+					const Core::Apu& apu = machine.cpu.GetApu();
+					const dword speed = apu.GetSpeed() ? apu.GetSpeed() : machine.cpu.GetFps();
+					const dword rate = apu.GetSampleRate() + slot.phase;
+
+					sound.samples[0] = samples + slot.length * slot.sampleSize;
+					sound.length[0] = rate / speed;
+					slot.phase = rate % speed;
+					slot.length += sound.length[0];
+				}
+
+				const Result result = emulator.Execute
+				(
+					(frame == 1 && (batch.output & OUTPUT_VIDEO)) ? &video : NULL,
+					(batch.output & OUTPUT_SOUND) ? &sound : NULL,
+					input
+				);
+
+				if (NES_FAILED(result))
+				{
+					slot.result = result;
+					break;
+				}
+			}
+
+			if (batch.output & OUTPUT_RAM)
+				std::memcpy( batch.ram.data + RAM_SIZE * index, machine.cpu.GetRam(), RAM_SIZE );
+		}
+
+		Result Batch::Execute(Core::Input::Controllers* const controllers,const uint n,const uint selection) throw()
+		{
+			if (!n)
+				return RESULT_ERR_INVALID_PARAM;
+
+			input = controllers;
+			frames = n;
+			output = selection;
+
+			const Result result = Reserve();
+
+			if (NES_FAILED(result))
+			{
+				output = 0;
+				return result;
+			}
+
+			callbacks[dispatchCallback]( &Step, this, count );
+
+			for (uint i=0; i < count; ++i)
+			{
+				if (NES_FAILED(slots[i].result))
+					return RESULT_ERR_GENERIC;
+			}
+
+			return RESULT_OK;
+		}
+
+		Result Batch::GetResult(uint index) const throw()
+		{
+			return (slots && index < count) ? slots[index].result : RESULT_ERR_INVALID_PARAM;
+		}
+
+		const void* Batch::GetVideo(uint index) const throw()
+		{
+			return ((output & OUTPUT_VIDEO) && index < count) ? video.data + video.stride * index : NULL;
+		}
+
+		long Batch::GetVideoPitch(uint index) const throw()
+		{
+			return ((output & OUTPUT_VIDEO) && index < count) ? slots[index].pitch : 0;
+		}
+
+		const void* Batch::GetSound(uint index) const throw()
+		{
+			return ((output & OUTPUT_SOUND) && index < count) ? sound.data + sound.stride * index : NULL;
+		}
+
+		uint Batch::GetSoundLength(uint index) const throw()
+		{
+			return ((output & OUTPUT_SOUND) && index < count) ? slots[index].length : 0;
+		}
+
+		const uchar* Batch::GetRam(uint index) const throw()
+		{
+			return ((output & OUTPUT_RAM) && index < count) ? ram.data + RAM_SIZE * index : NULL;
+		}
+	}
+}
@@ -0,0 +1,326 @@
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// Nestopia - NES/Famicom emulator written in C++
+//
+// Copyright (C) 2003-2008 Martin Freij
+//
+// This file is part of Nestopia.
+//
+// Nestopia is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Nestopia is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Nestopia; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef NST_API_BATCH_H
+#define NST_API_BATCH_H
+
+#include "NstApi.hpp"
+
+#ifdef NST_PRAGMA_ONCE
+#pragma once
+#endif
+
+#if NST_ICC >= 810
+#pragma warning( push )
+#pragma warning( disable : 304 444 )
+#elif NST_MSVC >= 1200
+#pragma warning( push )
+#pragma warning( disable : 4512 )
+#endif
+
+namespace Nes
+{
+	namespace Core
+	{
+		namespace Input
+		{
+			class Controllers;
+		}
+	}
+
+	namespace Api
+	{
+		class Emulator;
+
+		/**
+		* Batch execution interface.
+		*
+		* Steps a group of emulator instances in lock-step and gathers their
+		* output into buffers laid out one instance after the other. Instances
+		* are independent of each other and may be stepped concurrently by
+		* a user supplied dispatcher, see dispatchCallback.
+		*/
+		class Batch
+		{
+			struct DispatchCaller;
+			struct Slot;
+
+		public:
+
+			/**
+			* Constructor.
+			*
+			* The array is referenced, not copied, and must stay valid for the
+			* lifetime of this object.
+			*
+			* @param emulators array of emulator instances
+			* @param count number of instances
+			*/
+			Batch(Emulator* const* emulators,uint count) throw();
+
+			~Batch() throw();
+
+			enum
+			{
+				/**
+				* Size in bytes of the CPU RAM image of one instance.
+				*/
+				RAM_SIZE = 0x800
+			};
+
+			/**
+			* Output selection.
+			*/
+			enum
+			{
+				/**
+				* Render the last frame of a step to the video buffer.
+				*/
+				OUTPUT_VIDEO = 0x1,
+				/**
+				* Render the sound of every frame of a step to the sound buffer.
+				*/
+				OUTPUT_SOUND = 0x2,
+				/**
+				* Copy the CPU RAM to the RAM buffer after a step.
+				*/
+				OUTPUT_RAM = 0x4,
+				/**
+				* All of the above.
+				*/
+				OUTPUT_ALL = OUTPUT_VIDEO|OUTPUT_SOUND|OUTPUT_RAM
+			};
+
+			/**
+			* Executes a number of frames on every instance.
+			*
+			* Video and sound formats follow the current settings of each
+			* instance. The buffers are resized on demand and any pointers
+			* previously returned by this object may be invalidated.
+			*
+			* @param input array of input context objects, one per instance, or NULL to skip input
+			* @param frames number of frames to execute, at least 1
+			* @param output OR:ed combination of OUTPUT_VIDEO, OUTPUT_SOUND and OUTPUT_RAM
+			* @return result code, RESULT_ERR_GENERIC if any of the instances failed
+			*/
+			Result Execute(Core::Input::Controllers* input,uint frames=1,uint output=OUTPUT_ALL) throw();
+
+			/**
+			* Returns the number of instances.
+			*
+			* @return number
+			*/
+			uint Size() const throw()
+			{
+				return count;
+			}
+
+			/**
+			* Returns the result of the last step of an instance.
+			*
+			* @param index instance index
+			* @return result code
+			*/
+			Result GetResult(uint index) const throw();
+
+			/**
+			* Returns the video buffer of an instance.
+			*
+			* @param index instance index
+			* @return pixels or NULL if not available
+			*/
+			const void* GetVideo(uint index) const throw();
+
+			/**
+			* Returns the distance in bytes between two lines in the video buffer of an instance.
+			*
+			* @param index instance index
+			* @return pitch
+			*/
+			long GetVideoPitch(uint index) const throw();
+
+			/**
+			* Returns the distance in bytes between the video buffers of two consecutive instances.
+			*
+			* @return stride
+			*/
+			ulong GetVideoStride() const throw()
+			{
+				return video.stride;
+			}
+
+			/**
+			* Returns the sound buffer of an instance.
+			*
+			* @param index instance index
+			* @return samples or NULL if not available
+			*/
+			const void* GetSound(uint index) const throw();
+
+			/**
+			* Returns the number of samples written to the sound buffer of an instance.
+			*
+			* @param index instance index
+			* @return number of samples
+			*/
+			uint GetSoundLength(uint index) const throw();
+
+			/**
+			* Returns the distance in bytes between the sound buffers of two consecutive instances.
+			*
+			* @return stride
+			*/
+			ulong GetSoundStride() const throw()
+			{
+				return sound.stride;
+			}
+
+			/**
+			* Returns the RAM buffer of an instance.
+			*
+			* The RAM buffers of all instances are contiguous, RAM_SIZE bytes apart.
+			*
+			* @param index instance index
+			* @return CPU RAM image or NULL if not available
+			*/
+			const uchar* GetRam(uint index) const throw();
+
+			/**
+			* Job prototype.
+			*
+			* Steps a single instance.
+			*
+			* @param context context passed to the dispatcher
+			* @param index instance index
+			*/
+			typedef void (NST_CALLBACK *Job) (void* context,uint index);
+
+			/**
+			* Dispatch callback prototype.
+			*
+			* Must invoke the job exactly once for every index in [0,count) and
+			* not return until all of them have completed. Jobs may be run
+			* concurrently on any number of threads and in any order.
+			*
+			* @param userData optional user data
+			* @param job job to invoke
+			* @param context context to pass to the job
+			* @param count number of jobs
+			*/
+			typedef void (NST_CALLBACK *DispatchCallback) (void* userData,Job job,void* context,uint count);
+
+			/**
+			* Dispatch callback manager.
+			*
+			* Static object used for adding the user defined callback. It is the
+			* process-wide default, a batch overrides it with SetCallback(). If no
+			* callback is set the instances are stepped one by one on the
+			* calling thread.
+			*/
+			static DispatchCaller dispatchCallback;
+
+			/**
+			* Sets a callback for this batch only.
+			*
+			* Lets batches in the same process use different dispatchers, e.g.
+			* batch.SetCallback( Batch::dispatchCallback, f, pool ).
+			*
+			* @param callback static callback manager to override
+			* @param function callback function, NULL steps the instances on the calling thread
+			* @param userData optional user data
+			*/
+			template<typename T>
+			void SetCallback(const T& callback,typename T::Function function,void* userData) throw()
+			{
+				callbacks.Set( callback, function, userData );
+			}
+
+			/**
+			* Removes a callback previously set for this batch.
+			*
+			* @param callback static callback manager
+			*/
+			template<typename T>
+			void UnsetCallback(const T& callback) throw()
+			{
+				callbacks.Unset( callback );
+			}
+
+		private:
+
+			static void NST_CALLBACK Step(void*,uint);
+
+			Result Reserve();
+
+			struct Buffer
+			{
+				Buffer();
+				~Buffer();
+
+				bool Reserve(uint,ulong);
+
+				uchar* data;
+				ulong stride;
+				ulong capacity;
+			};
+
+			Emulator* const* const emulators;
+			const uint count;
+			Slot* slots;
+			Core::Input::Controllers* input;
+			uint frames;
+			uint output;
+			Buffer video;
+			Buffer sound;
+			Buffer ram;
+			Core::UserCallbacks callbacks;
+		};
+
+		/**
+		* Dispatch callback invoker.
+		*
+		* Used internally by the core.
+		*/
+		struct Batch::DispatchCaller : Core::UserCallback<Batch::DispatchCallback>
+		{
+			void operator () (Job job,void* context,uint count) const
+			{
+				if (function)
+				{
+					function( userdata, job, context, count );
+				}
+				else for (uint i=0; i < count; ++i)
+				{
+					job( context, i );
+				}
+			}
+		};
+	}
+}
+
+#if NST_MSVC >= 1200 || NST_ICC >= 810
+#pragma warning( pop )
+#endif
+
+#endif
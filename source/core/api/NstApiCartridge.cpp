@@ -366,7 +366,7 @@ namespace Nes
 
 		bool Cartridge::Database::IsEnabled() const throw()
 		{
-			return emulator.imageDatabase && emulator.imageDatabase->Enabled();
+			return emulator.imageDatabase && emulator.imageDatabaseEnabled;
 		}
 
 		bool Cartridge::Database::Create()
@@ -377,29 +377,59 @@ namespace Nes
 			return emulator.imageDatabase;
 		}
 
+		bool Cartridge::Database::Detach()
+		{
+			// copy-on-write, loading into or unloading a shared database
+			// starts a private one for this instance
+
+			if (emulator.imageDatabase && emulator.imageDatabase->Shared())
+			{
+				emulator.imageDatabase->Release();
+				emulator.imageDatabase = NULL;
+			}
+
+			return Create();
+		}
+
 		Result Cartridge::Database::Load(std::istream& stream) throw()
 		{
-			return Create() ? emulator.imageDatabase->Load( stream ) : RESULT_ERR_OUT_OF_MEMORY;
+			return Detach() ? emulator.imageDatabase->Load( stream, emulator.cpu.GetCallbacks() ) : RESULT_ERR_OUT_OF_MEMORY;
 		}
 
 		Result Cartridge::Database::Load(std::istream& baseStream,std::istream& overloadStream) throw()
 		{
-			return Create() ? emulator.imageDatabase->Load( baseStream, overloadStream ) : RESULT_ERR_OUT_OF_MEMORY;
+			return Detach() ? emulator.imageDatabase->Load( baseStream, overloadStream, emulator.cpu.GetCallbacks() ) : RESULT_ERR_OUT_OF_MEMORY;
 		}
 
 		void Cartridge::Database::Unload() throw()
 		{
-			if (emulator.imageDatabase)
+			if (emulator.imageDatabase && Detach())
 				emulator.imageDatabase->Unload();
 		}
 
+		Result Cartridge::Database::Share(Core::Machine& instance) throw()
+		{
+			if (instance.imageDatabase == NULL)
+				return RESULT_ERR_NOT_READY;
+
+			if (instance.imageDatabase == emulator.imageDatabase)
+				return RESULT_NOP;
+
+			if (emulator.imageDatabase)
+				emulator.imageDatabase->Release();
+
+			emulator.imageDatabase = instance.imageDatabase->Attach();
+
+			return RESULT_OK;
+		}
+
 		Result Cartridge::Database::Enable(bool state) throw()
 		{
 			if (Create())
 			{
-				if (emulator.imageDatabase->Enabled() != state)
+				if (emulator.imageDatabaseEnabled != state)
 				{
-					emulator.imageDatabase->Enable( state );
+					emulator.imageDatabaseEnabled = state;
 					return RESULT_OK;
 				}
 
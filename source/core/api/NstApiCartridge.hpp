@@ -856,6 +856,7 @@ namespace Nes
 				Core::Machine& emulator;
 
 				bool Create();
+				bool Detach();
 
 			public:
 
@@ -1015,6 +1016,22 @@ namespace Nes
 				*/
 				void Unload() throw();
 
+				/**
+				* Shares the databases of another emulator instance.
+				*
+				* Saves the memory and time of loading the same databases into
+				* every instance. Loading or unloading afterwards gives this
+				* instance its own databases and leaves the other instances
+				* untouched. Enabling is kept per instance and never affects
+				* the shared databases. The reference count isn't atomic, so
+				* sharing and destroying instances that share the same databases
+				* must not happen concurrently.
+				*
+				* @param instance emulator instance to share with
+				* @return result code
+				*/
+				Result Share(Core::Machine& instance) throw();
+
 				/**
 				* Enables image corrections.
 				*
@@ -22,8 +22,10 @@
 //
 ////////////////////////////////////////////////////////////////////////////////////////
 
+#include <new>
 #include "../NstMachine.hpp"
 #include "NstApiEmulator.hpp"
+#include "NstApiInput.hpp"
 
 namespace Nes
 {
@@ -61,5 +63,46 @@ namespace Nes
 		{
 			return machine.tracker.Frame();
 		}
+
+		Result Emulator::Clone(Emulator& instance) throw()
+		{
+			if (&instance == this)
+				return RESULT_ERR_INVALID_PARAM;
+
+			try
+			{
+				const Input source( *this );
+				Input target( instance );
+
+				for (uint port=0; port < Input::NUM_PORTS; ++port)
+				{
+					const Result result = target.ConnectController( port, source.GetConnectedController( port ) );
+
+					if (NES_FAILED(result))
+						return result;
+				}
+
+				target.ConnectAdapter( source.GetConnectedAdapter() );
+
+				return machine.Clone( instance.machine );
+			}
+			catch (Result result)
+			{
+				return result;
+			}
+			catch (const std::bad_alloc&)
+			{
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (...)
+			{
+				return RESULT_ERR_GENERIC;
+			}
+		}
+
+		Core::UserCallbacks& Emulator::GetCallbacks() throw()
+		{
+			return machine.cpu.GetCallbacks();
+		}
 	}
 }
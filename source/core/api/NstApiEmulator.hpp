@@ -25,9 +25,7 @@
 #ifndef NST_API_EMULATOR_H
 #define NST_API_EMULATOR_H
 
-#ifndef NST_BASE_H
-#include "../NstBase.hpp"
-#endif
+#include "NstApi.hpp"
 
 #ifdef NST_PRAGMA_ONCE
 #pragma once
@@ -93,8 +91,55 @@ namespace Nes
 			*/
 			ulong Frame() const throw();
 
+			/**
+			* Turns another instance into a copy of this one.
+			*
+			* Loads the same cartridge into the other instance and copies the
+			* complete machine state, including the connected controllers. Read-only
+			* data such as PRG/CHR-ROM is shared rather than copied and lives for as
+			* long as any instance uses it. The copy runs independently of this one
+			* and never reads or writes battery save files. The shared data is
+			* reference counted without atomic operations, so all clones of one
+			* machine, the original included, must be created, unloaded and
+			* destroyed on a single thread.
+			*
+			* @param instance emulator instance to turn into a copy
+			* @return result code
+			*/
+			Result Clone(Emulator& instance) throw();
+
+			/**
+			* Sets a callback for this instance only.
+			*
+			* The override takes precedence over the static callback manager
+			* it is keyed by, which otherwise applies to every instance in the
+			* process, e.g. emulator.SetCallback( User::logCallback, f, data ).
+			*
+			* @param callback static callback manager to override
+			* @param function callback function, NULL silences it for this instance
+			* @param userData optional user data
+			*/
+			template<typename T>
+			void SetCallback(const T& callback,typename T::Function function,void* userData) throw()
+			{
+				GetCallbacks().Set( callback, function, userData );
+			}
+
+			/**
+			* Removes a callback previously set for this instance.
+			*
+			* @param callback static callback manager
+			*/
+			template<typename T>
+			void UnsetCallback(const T& callback) throw()
+			{
+				GetCallbacks().Unset( callback );
+			}
+
 		private:
 
+			Core::UserCallbacks& GetCallbacks() throw();
+
 			Core::Machine& machine;
 
 		public:
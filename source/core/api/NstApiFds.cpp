@@ -136,7 +136,7 @@ namespace Nes
 					stream.Seek( offset );
 				}
 
-				Core::Fds::SetBios( stdStream );
+				Core::Fds::SetBios( stdStream, emulator.cpu.GetCallbacks() );
 			}
 			catch (Result result)
 			{
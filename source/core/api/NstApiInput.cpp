@@ -357,7 +357,7 @@ namespace Nes
 
 			delete old;
 			emulator.InitializeInputDevices();
-			controllerCallback( port, type );
+			emulator.cpu.GetCallbacks()[controllerCallback]( port, type );
 
 			return RESULT_OK;
 		}
@@ -366,7 +366,7 @@ namespace Nes
 		{
 			if (emulator.extPort->SetType( adapter ))
 			{
-				adapterCallback( adapter );
+				emulator.cpu.GetCallbacks()[adapterCallback]( adapter );
 				return RESULT_OK;
 			}
 			else
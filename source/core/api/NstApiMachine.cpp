@@ -269,8 +269,113 @@ namespace Nes
 			return RESULT_OK;
 		}
 
+		Result Machine::SetRunAhead(uint frames) throw()
+		{
+			return emulator.tracker.SetRunAhead( frames );
+		}
+
+		uint Machine::GetRunAhead() const throw()
+		{
+			return emulator.tracker.GetRunAhead();
+		}
+
+		Result Machine::EnableIdleLoopSkip(bool state) throw()
+		{
+			if (emulator.cpu.HasIdleSkip() == state)
+				return RESULT_NOP;
+
+			emulator.cpu.EnableIdleSkip( state );
+			return RESULT_OK;
+		}
+
+		bool Machine::IsIdleLoopSkipEnabled() const throw()
+		{
+			return emulator.cpu.HasIdleSkip();
+		}
+
+		ulong Machine::GetStateSize() const throw()
+		{
+			if (!Is(GAME,ON))
+				return 0;
+
+			try
+			{
+				Core::State::Saver saver( static_cast<byte*>(NULL), 0, false );
+				emulator.SaveState( saver );
+				return saver.Size();
+			}
+			catch (...)
+			{
+				return 0;
+			}
+		}
+
 		#ifdef NST_MSVC_OPTIMIZE
 		#pragma optimize("", on)
 		#endif
+
+		Result Machine::LoadState(const void* data,ulong size) throw()
+		{
+			if (!Is(GAME,ON) || IsLocked())
+				return RESULT_ERR_NOT_READY;
+
+			if (!data || !size)
+				return RESULT_ERR_INVALID_PARAM;
+
+			try
+			{
+				emulator.tracker.Resync();
+				Core::State::Loader loader( static_cast<const byte*>(data), size, true );
+
+				if (emulator.LoadState( loader, true ))
+					return RESULT_OK;
+				else
+					return RESULT_ERR_INVALID_CRC;
+			}
+			catch (Result result)
+			{
+				return result;
+			}
+			catch (const std::bad_alloc&)
+			{
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (...)
+			{
+				return RESULT_ERR_GENERIC;
+			}
+		}
+
+		Result Machine::SaveState(void* data,ulong size) const throw()
+		{
+			if (!Is(GAME,ON))
+				return RESULT_ERR_NOT_READY;
+
+			if (!data)
+				return RESULT_ERR_INVALID_PARAM;
+
+			try
+			{
+				Core::State::Saver saver( static_cast<byte*>(data), size, false );
+				emulator.SaveState( saver );
+
+				if (saver.Overflowed())
+					return RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (Result result)
+			{
+				return result;
+			}
+			catch (const std::bad_alloc&)
+			{
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (...)
+			{
+				return RESULT_ERR_GENERIC;
+			}
+
+			return RESULT_OK;
+		}
 	}
 }
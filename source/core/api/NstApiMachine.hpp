@@ -310,6 +310,98 @@ namespace Nes
 			*/
 			Result SaveState(std::ostream& stream,Compression compression=USE_COMPRESSION) const throw();
 
+			/**
+			* Returns the exact size of a state saved to memory.
+			*
+			* Computed on every call by a counting pass over the state that
+			* writes no memory, which costs about as much as saving to memory.
+			* The size isn't cached: besides following the machine configuration
+			* it also follows the emulated state, since optional chunks such as
+			* a pending APU frame IRQ come and go while a game runs. Query it
+			* right before saving rather than once per loaded image.
+			*
+			* @return size in bytes or 0 if no state can be saved
+			*/
+			ulong GetStateSize() const throw();
+
+			/**
+			* Loads a state from memory.
+			*
+			* Accepts states saved by either of the SaveState() functions as long
+			* as they were saved without compression. Like the stream version the
+			* state is checked against the CRC of the loaded image and the user
+			* is asked whether to continue on a mismatch.
+			*
+			* @param data state
+			* @param size size of state in bytes
+			* @return result code
+			*/
+			Result LoadState(const void* data,ulong size) throw();
+
+			/**
+			* Saves a state to memory.
+			*
+			* Fast path for frequent saving, as in rewinding or run-ahead. Nothing
+			* is compressed or allocated and the output matches that of SaveState()
+			* with NO_COMPRESSION.
+			*
+			* @param data buffer which the state will be written to
+			* @param size size of buffer in bytes, at least GetStateSize()
+			* @return result code, RESULT_ERR_OUT_OF_MEMORY if the buffer is too small
+			*/
+			Result SaveState(void* data,ulong size) const throw();
+
+			enum
+			{
+				/**
+				* Maximum number of frames to run ahead.
+				*/
+				MAX_RUN_AHEAD = 4
+			};
+
+			/**
+			* Sets the number of frames to run ahead.
+			*
+			* Cuts input latency by emulating hidden frames past the current one
+			* and presenting the last of them, after which the machine is rolled
+			* back. Hidden frames produce no sound and input is polled once for
+			* every emulated frame. Ignored while the rewinder is enabled or a
+			* movie is playing or recording.
+			*
+			* @param frames number of frames, 0 to disable, at most MAX_RUN_AHEAD
+			* @return result code
+			*/
+			Result SetRunAhead(uint frames) throw();
+
+			/**
+			* Returns the number of frames to run ahead.
+			*
+			* @return number of frames, 0 if disabled
+			*/
+			uint GetRunAhead() const throw();
+
+			/**
+			* Skips ahead over idle polling loops.
+			*
+			* Detects short loops that only read RAM or ROM and branch back on
+			* themselves, such as a JMP to itself or a load and branch waiting
+			* for the NMI handler to update a variable, and advances the CPU
+			* clock to the next scheduled event in one go. Results are identical
+			* to executing the loop. Loops polling I/O registers are executed as
+			* usual. Not available while mapper hooks are active.
+			*
+			* @param state true to enable, default is false
+			* @return result code
+			*/
+			Result EnableIdleLoopSkip(bool state) throw();
+
+			/**
+			* Checks if idle loops are skipped.
+			*
+			* @return true if enabled
+			*/
+			bool IsIdleLoopSkipEnabled() const throw();
+
 			/**
 			* Returns a machine state.
 			*
@@ -87,6 +87,11 @@ namespace Nes
 			emulator.cpu.GetApu().EnableStereo( speaker == SPEAKER_STEREO );
 		}
 
+		void Sound::SetSynthesis(Synthesis synthesis) throw()
+		{
+			emulator.cpu.GetApu().EnableBandLimiting( synthesis == SYNTHESIS_BANDLIMITED );
+		}
+
 		ulong Sound::GetSampleRate() const throw()
 		{
 			return emulator.cpu.GetApu().GetSampleRate();
@@ -107,6 +112,16 @@ namespace Nes
 			return emulator.cpu.GetApu().GetSpeed();
 		}
 
+		Result Sound::SetResampling(Resampling resampling) throw()
+		{
+			return emulator.cpu.GetApu().SetResampling( resampling );
+		}
+
+		Sound::Resampling Sound::GetResampling() const throw()
+		{
+			return static_cast<Resampling>(emulator.cpu.GetApu().GetResampling());
+		}
+
 		void Sound::Mute(bool mute) throw()
 		{
 			emulator.cpu.GetApu().Mute( mute );
@@ -132,6 +147,11 @@ namespace Nes
 			return emulator.cpu.GetApu().InStereo() ? SPEAKER_STEREO : SPEAKER_MONO;
 		}
 
+		Sound::Synthesis Sound::GetSynthesis() const throw()
+		{
+			return emulator.cpu.GetApu().IsBandLimiting() ? SYNTHESIS_BANDLIMITED : SYNTHESIS_AVERAGED;
+		}
+
 		void Sound::EmptyBuffer() throw()
 		{
 			emulator.cpu.GetApu().ClearBuffers();
@@ -249,6 +249,48 @@ namespace Nes
 				SPEAKER_STEREO
 			};
 
+			/**
+			* Synthesis method for the built-in APU channels.
+			*/
+			enum Synthesis
+			{
+				/**
+				* Per-sample averaging of the channel outputs (default).
+				*/
+				SYNTHESIS_AVERAGED,
+				/**
+				* Band-limited steps placed at their exact clock positions.
+				* Falls back to averaging for games using expansion sound.
+				*/
+				SYNTHESIS_BANDLIMITED
+			};
+
+			/**
+			* Resampling quality.
+			*
+			* When enabled, sound is rendered internally at twice the output
+			* rate, but no less than 96 kHz, and converted with a polyphase filter.
+			*/
+			enum Resampling
+			{
+				/**
+				* Render directly at the output rate (default).
+				*/
+				RESAMPLING_NONE,
+				/**
+				* 8-tap filter.
+				*/
+				RESAMPLING_LOW,
+				/**
+				* 16-tap filter.
+				*/
+				RESAMPLING_MEDIUM,
+				/**
+				* 32-tap filter.
+				*/
+				RESAMPLING_HIGH
+			};
+
 			enum
 			{
 				DEFAULT_VOLUME = 85,
@@ -303,6 +345,20 @@ namespace Nes
 			*/
 			Speaker GetSpeaker() const throw();
 
+			/**
+			* Sets the synthesis method.
+			*
+			* @param synthesis synthesis method, default is SYNTHESIS_AVERAGED
+			*/
+			void SetSynthesis(Synthesis synthesis) throw();
+
+			/**
+			* Returns the synthesis method.
+			*
+			* @return synthesis method
+			*/
+			Synthesis GetSynthesis() const throw();
+
 			/**
 			* Sets one or more channel volumes.
 			*
@@ -349,6 +405,21 @@ namespace Nes
 			*/
 			uint GetSpeed() const throw();
 
+			/**
+			* Sets the resampling quality.
+			*
+			* @param resampling resampling quality, default is RESAMPLING_NONE
+			* @return result code
+			*/
+			Result SetResampling(Resampling resampling) throw();
+
+			/**
+			* Returns the resampling quality.
+			*
+			* @return resampling quality
+			*/
+			Resampling GetResampling() const throw();
+
 			/**
 			* Enables automatic transposition.
 			*
@@ -34,6 +34,7 @@ namespace Nes
 		{
 			Output::Locker Output::lockCallback;
 			Output::Unlocker Output::unlockCallback;
+			Output::Dispatcher Output::dispatchCallback;
 		}
 	}
 
@@ -63,6 +64,45 @@ namespace Nes
 			return !emulator.ppu.HasSpriteLimit();
 		}
 
+		Result Video::EnableRenderSkip(bool state) throw()
+		{
+			if (emulator.ppu.HasRenderSkip() == state)
+				return RESULT_NOP;
+
+			emulator.ppu.EnableRenderSkip( state );
+			return RESULT_OK;
+		}
+
+		bool Video::IsRenderSkipEnabled() const throw()
+		{
+			return emulator.ppu.HasRenderSkip();
+		}
+
+		Result Video::EnablePersistentOutput(bool state) throw()
+		{
+			return emulator.renderer.EnablePersistentOutput( state );
+		}
+
+		bool Video::IsPersistentOutputEnabled() const throw()
+		{
+			return emulator.renderer.IsPersistentOutputEnabled();
+		}
+
+		Result Video::EnableFrameHash(bool state) throw()
+		{
+			return emulator.renderer.EnableFrameHash( state );
+		}
+
+		bool Video::IsFrameHashEnabled() const throw()
+		{
+			return emulator.renderer.IsFrameHashEnabled();
+		}
+
+		Result Video::GetFrameHash(dword (&hash)[2]) const throw()
+		{
+			return emulator.renderer.GetFrameHash( hash );
+		}
+
 		int Video::GetBrightness() const throw()
 		{
 			return emulator.renderer.GetBrightness();
@@ -188,6 +228,16 @@ namespace Nes
 			return emulator.renderer.IsFieldMergingEnabled();
 		}
 
+		void Video::EnableNtscRowCache(bool state) throw()
+		{
+			emulator.renderer.EnableNtscRowCache( state );
+		}
+
+		bool Video::IsNtscRowCacheEnabled() const throw()
+		{
+			return emulator.renderer.IsNtscRowCacheEnabled();
+		}
+
 		Result Video::SetRenderState(const RenderState& state) throw()
 		{
 			const Result result = emulator.renderer.SetState( state );
@@ -207,7 +257,7 @@ namespace Nes
 		{
 			if (emulator.renderer.IsReady())
 			{
-				emulator.renderer.Blit( output, emulator.ppu.GetScreen(), emulator.ppu.GetBurstPhase() );
+				emulator.renderer.Blit( output, emulator.ppu.GetScreen(), emulator.ppu.GetBurstPhase(), emulator.cpu.GetCallbacks() );
 				return RESULT_OK;
 			}
 
@@ -216,9 +266,10 @@ namespace Nes
 
 		Video::RenderState::RenderState() throw()
 		:
-		width  (0),
-		height (0),
-		filter (FILTER_NONE)
+		width   (0),
+		height  (0),
+		filter  (FILTER_NONE),
+		threads (1)
 		{
 			bits.count = 0;
 			bits.mask.r = 0;
@@ -52,6 +52,7 @@ namespace Nes
 			{
 				struct Locker;
 				struct Unlocker;
+				struct Dispatcher;
 
 			public:
 
@@ -112,6 +113,41 @@ namespace Nes
 				* Static object used for adding the user defined callback.
 				*/
 				static Unlocker unlockCallback;
+
+				/**
+				* Job prototype.
+				*
+				* Filters one band of lines.
+				*
+				* @param context context passed to the dispatcher
+				* @param index band index
+				*/
+				typedef void (NST_CALLBACK *Job) (void* context,uint index);
+
+				/**
+				* Dispatch callback prototype.
+				*
+				* Called between the surface lock and unlock when the render state
+				* asks for more than one thread. Must invoke the job exactly once for
+				* every index in [0,count) and not return until all of them have
+				* completed. Jobs write to disjoint lines of the surface and may be
+				* run concurrently on any number of threads and in any order.
+				*
+				* @param userData optional user data
+				* @param job job to invoke
+				* @param context context to pass to the job
+				* @param count number of jobs
+				*/
+				typedef void (NST_CALLBACK *DispatchCallback) (void* userData,Job job,void* context,uint count);
+
+				/**
+				* Dispatch callback manager.
+				*
+				* Static object used for adding the user defined callback. If no
+				* callback is set the bands are filtered one by one on the calling
+				* thread.
+				*/
+				static Dispatcher dispatchCallback;
 			};
 
 			/**
@@ -140,6 +176,26 @@ namespace Nes
 						function( userdata, output );
 				}
 			};
+
+			/**
+			* Dispatch callback invoker.
+			*
+			* Used internally by the core.
+			*/
+			struct Output::Dispatcher : UserCallback<Output::DispatchCallback>
+			{
+				void operator () (Job job,void* context,uint count) const
+				{
+					if (function)
+					{
+						function( userdata, job, context, count );
+					}
+					else for (uint i=0; i < count; ++i)
+					{
+						job( context, i );
+					}
+				}
+			};
 		}
 	}
 
@@ -222,6 +278,78 @@ namespace Nes
 			*/
 			bool AreUnlimSpritesEnabled() const throw();
 
+			/**
+			* Skips pixel output on frames executed without a video output.
+			*
+			* PPU timing and everything visible to the game, such as sprite 0 hit,
+			* status flags and mapper IRQs, stay exact. Frames are still rendered
+			* while a light gun is connected or the rewinder is rewinding. Blit()
+			* will show the last rendered frame.
+			*
+			* @param state true to skip, default is false
+			* @return result code
+			*/
+			Result EnableRenderSkip(bool state) throw();
+
+			/**
+			* Checks if pixel output is skipped on frames without a video output.
+			*
+			* @return true if enabled
+			*/
+			bool IsRenderSkipEnabled() const throw();
+
+			/**
+			* Lets Blit() refilter only the lines that changed since the previous call.
+			*
+			* The surface passed to Blit() must keep its contents between calls.
+			* A new surface address or pitch, a render state or palette change
+			* and a new burst phase with the NTSC filter force a full blit. The
+			* NTSC and unfiltered paths skip unchanged lines, the scaling filters
+			* only skip frames where nothing changed.
+			*
+			* @param state true to enable, default is false
+			* @return result code
+			*/
+			Result EnablePersistentOutput(bool state) throw();
+
+			/**
+			* Checks if Blit() refilters only the lines that changed.
+			*
+			* @return true if enabled
+			*/
+			bool IsPersistentOutputEnabled() const throw();
+
+			/**
+			* Computes a 64-bit hash of every rendered frame.
+			*
+			* The hash covers the pixels, the palette, the background color used for
+			* padding and the burst phase when the NTSC filter depends on it. It is
+			* ready before the frame is passed to the output, so a frontend can skip
+			* presenting a frame equal to the last one. The value does not depend on
+			* the platform and can serve as a fingerprint for regression tests.
+			*
+			* @param state true to enable, default is false
+			* @return result code
+			*/
+			Result EnableFrameHash(bool state) throw();
+
+			/**
+			* Checks if the frame hash is computed.
+			*
+			* @return true if enabled
+			*/
+			bool IsFrameHashEnabled() const throw();
+
+			/**
+			* Returns the hash of the last rendered frame.
+			*
+			* May be called from the surface unlock callback.
+			*
+			* @param hash receives the lower and upper 32 bits
+			* @return result code, RESULT_ERR_NOT_READY if disabled or no frame has been rendered yet
+			*/
+			Result GetFrameHash(dword (&hash)[2]) const throw();
+
 			/**
 			* Returns the current brightness.
 			*
@@ -396,6 +524,25 @@ namespace Nes
 			*/
 			bool IsFieldMergingEnabled() const throw();
 
+			/**
+			* Enables the NTSC filter row cache.
+			*
+			* Keeps the filtered output of every line for each burst phase and
+			* copies it instead of filtering again when the line and the
+			* background color are unchanged. Useful without field merging, where
+			* a line only repeats its burst phase every third frame. Uses about 2 MB.
+			*
+			* @param state true to enable
+			*/
+			void EnableNtscRowCache(bool state) throw();
+
+			/**
+			* Checks if the NTSC filter row cache is enabled.
+			*
+			* @return true if enabled
+			*/
+			bool IsNtscRowCacheEnabled() const throw();
+
 			/**
 			* Performs a manual blit to the video output object.
 			*
@@ -739,6 +886,13 @@ namespace Nes
 				* Filter.
 				*/
 				Filter filter;
+
+				/**
+				* Number of bands of lines the filter is split into, one per thread.
+				* The bands are passed to Output::dispatchCallback. 0 or 1 (default)
+				* filters the whole frame on the calling thread.
+				*/
+				uint threads;
 			};
 
 			/**
@@ -185,7 +185,7 @@ namespace Nes
 			{
 			}
 
-			Board::Type::Type(Id i,Ram& prgRom,Ram& chrRom,Nmt n,bool b,bool a)
+			Board::Type::Type(Id i,Ram& prgRom,Ram& chrRom,Nmt n,bool b,bool a,const UserCallbacks& callbacks)
 			: id(i), battery(b)
 			{
 				wramAuto = (a && GetWram() >= SIZE_8K);
@@ -198,7 +198,7 @@ namespace Nes
 				if (prgRom.Size() != oldPrg)
 				{
 					NST_DEBUG_MSG("PRG-ROM truncated!");
-					Log::Flush( "Board: warning, PRG-ROM truncated" NST_LINEBREAK );
+					Log::Flush( callbacks, "Board: warning, PRG-ROM truncated" NST_LINEBREAK );
 				}
 
 				switch (dword(id) >> 7 & 0x7)
@@ -226,7 +226,7 @@ namespace Nes
 				if (chrRom.Size() != oldChr)
 				{
 					NST_DEBUG_MSG("CHR-ROM truncated!");
-					Log::Flush( "Board: warning, CHR-ROM truncated" NST_LINEBREAK );
+					Log::Flush( callbacks, "Board: warning, CHR-ROM truncated" NST_LINEBREAK );
 				}
 
 				switch (dword(i) >> 4 & 0x7)
@@ -357,9 +357,9 @@ namespace Nes
 
 				vram.Fill( 0x00 );
 
-				if (Log::Available())
+				if (Log::Available( context.callbacks ))
 				{
-					Log log;
+					Log log( context.callbacks );
 
 					log << "Board: " << context.name << NST_LINEBREAK;
 					log << "Board: " << (context.prg.Size() / SIZE_1K) << "k PRG-ROM" NST_LINEBREAK;
@@ -389,6 +389,11 @@ namespace Nes
 				cpu.Map( 0xC000, 0xDFFF ).Set( this, &Board::Peek_Prg_C, &Board::Poke_Nop );
 				cpu.Map( 0xE000, 0xFFFF ).Set( this, &Board::Peek_Prg_E, &Board::Poke_Nop );
 
+				cpu.MapDirect( 0x8000, 0x9FFF, prg.Slot(0), SIZE_8K-1 );
+				cpu.MapDirect( 0xA000, 0xBFFF, prg.Slot(1), SIZE_8K-1 );
+				cpu.MapDirect( 0xC000, 0xDFFF, prg.Slot(2), SIZE_8K-1 );
+				cpu.MapDirect( 0xE000, 0xFFFF, prg.Slot(3), SIZE_8K-1 );
+
 				if (hard)
 				{
 					wrk.Source().SetSecurity( true, board.GetWram() > 0 );
@@ -711,7 +716,8 @@ namespace Nes
 				Type::Nmt n,
 				bool wb,
 				bool mb,
-				Chips& h
+				Chips& h,
+				const UserCallbacks& u
 			)
 			:
 			name        (""),
@@ -724,7 +730,8 @@ namespace Nes
 			nmt         (n),
 			chips       (h),
 			wramBattery (wb),
-			mmcBattery  (mb)
+			mmcBattery  (mb),
+			callbacks   (u)
 			{
 			}
 
@@ -1203,7 +1210,7 @@ namespace Nes
 						break;
 				}
 
-				type = Type( id, prg, chr, nmt, wramBattery || mmcBattery, false );
+				type = Type( id, prg, chr, nmt, wramBattery || mmcBattery, false, callbacks );
 
 				return true;
 			}
@@ -3182,7 +3189,7 @@ namespace Nes
 						return false;
 				}
 
-				type = Type( id, this->prg, this->chr, nmt, wramBattery || mmcBattery, wramAuto );
+				type = Type( id, this->prg, this->chr, nmt, wramBattery || mmcBattery, wramAuto, callbacks );
 
 				return true;
 			}
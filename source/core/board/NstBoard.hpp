@@ -573,7 +573,7 @@ namespace Nes
 					};
 
 					Type();
-					Type(Id,Ram&,Ram&,Nmt,bool,bool);
+					Type(Id,Ram&,Ram&,Nmt,bool,bool,const UserCallbacks&);
 
 					uint  GetMapper() const;
 					dword GetMaxPrg() const;
@@ -635,7 +635,7 @@ namespace Nes
 
 				public:
 
-					Context(Cpu*,Apu*,Ppu*,Ram&,Ram&,const Ram&,Type::Nmt,bool,bool,Chips&);
+					Context(Cpu*,Apu*,Ppu*,Ram&,Ram&,const Ram&,Type::Nmt,bool,bool,Chips&,const UserCallbacks&);
 
 					bool DetectBoard(wcstring,dword);
 					bool DetectBoard(byte,dword,bool);
@@ -652,6 +652,7 @@ namespace Nes
 					Chips& chips;
 					const bool wramBattery;
 					const bool mmcBattery;
+					const UserCallbacks& callbacks;
 				};
 
 				static Board* Create(const Context&);
@@ -41,7 +41,7 @@ namespace Nes
 				AerobicsStudio::AerobicsStudio(const Context& c)
 				:
 				CnRom (c),
-				sound (Sound::Player::Create(*c.apu,c.chips,NULL,Sound::Player::GAME_AEROBICS_STUDIO,8))
+				sound (Sound::Player::Create(*c.apu,c.cpu->GetCallbacks(),c.chips,NULL,Sound::Player::GAME_AEROBICS_STUDIO,8))
 				{}
 
 				AerobicsStudio::~AerobicsStudio()
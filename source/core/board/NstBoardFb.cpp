@@ -38,7 +38,7 @@ namespace Nes
 			#endif
 
 			Fb::Fb(const Context& c)
-			: Board(c), cartSwitch(wrk) {}
+			: Board(c), cartSwitch(wrk,c.cpu->GetCallbacks()) {}
 
 			void Fb::SubReset(const bool hard)
 			{
@@ -79,8 +79,8 @@ namespace Nes
 					return Board::QueryDevice( type );
 			}
 
-			Fb::CartSwitch::CartSwitch(Wrk& w)
-			: wrk(w), init(true) {}
+			Fb::CartSwitch::CartSwitch(Wrk& w,const UserCallbacks& c)
+			: wrk(w), callbacks(c), init(true) {}
 
 			void Fb::CartSwitch::Reset(bool hard)
 			{
@@ -99,7 +99,7 @@ namespace Nes
 				if (wrk.Source().Writable())
 				{
 					wrk.Source().Fill( 0x00 );
-					Log::Flush( "Fb: battery-switch OFF, discarding W-RAM.." NST_LINEBREAK );
+					Log::Flush( callbacks, "Fb: battery-switch OFF, discarding W-RAM.." NST_LINEBREAK );
 				}
 			}
 
@@ -47,7 +47,7 @@ namespace Nes
 				{
 				public:
 
-					explicit CartSwitch(Wrk&);
+					CartSwitch(Wrk&,const UserCallbacks&);
 
 					void Flush() const;
 					void Reset(bool);
@@ -55,6 +55,7 @@ namespace Nes
 				private:
 
 					Wrk& wrk;
+					const UserCallbacks& callbacks;
 					bool init;
 
 					uint NumDips() const;
@@ -41,7 +41,7 @@ namespace Nes
 				Jf19::Jf19(const Context& c)
 				:
 				Board (c),
-				sound (Sound::Player::Create(*c.apu,c.chips,L"D7756C",board == Type::JALECO_JF19 ? Sound::Player::GAME_MOERO_PRO_YAKYUU_88 : Sound::Player::GAME_UNKNOWN,32))
+				sound (Sound::Player::Create(*c.apu,c.cpu->GetCallbacks(),c.chips,L"D7756C",board == Type::JALECO_JF19 ? Sound::Player::GAME_MOERO_PRO_YAKYUU_88 : Sound::Player::GAME_UNKNOWN,32))
 				{
 				}
 
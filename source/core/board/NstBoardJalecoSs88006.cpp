@@ -58,6 +58,7 @@ namespace Nes
 					Sound::Player::Create
 					(
 						*c.apu,
+						c.cpu->GetCallbacks(),
 						c.chips,
 						L"D7756C",
 						board == Type::JALECO_JF24 ? Sound::Player::GAME_TERAO_NO_DOSUKOI_OOZUMOU :
@@ -988,6 +988,12 @@ namespace Nes
 				{
 					if (output)
 					{
+						// rendered one sample at a time on purpose, every $9030 write syncs
+						// the APU up to the current cycle and each call covers only about
+						// one OPLL tick at common rates, so there's no block to batch, and
+						// each operator is a serial chain of table lookups that SSE2 can't
+						// gather; channel-major and per-stage passes measured slower
+
 						while (samplePhase < sampleRate)
 						{
 							samplePhase += CLOCK_RATE;
@@ -41,10 +41,10 @@ namespace Nes
 			{
 				switch (rev)
 				{
-					case REV_A:  Log::Flush( "Board: MMC rev. A"  NST_LINEBREAK ); break;
-					case REV_B1: Log::Flush( "Board: MMC rev. B1" NST_LINEBREAK ); break;
-					case REV_B2: Log::Flush( "Board: MMC rev. B2" NST_LINEBREAK ); break;
-					case REV_B3: Log::Flush( "Board: MMC rev. B3" NST_LINEBREAK ); break;
+					case REV_A:  Log::Flush( cpu.GetCallbacks(), "Board: MMC rev. A"  NST_LINEBREAK ); break;
+					case REV_B1: Log::Flush( cpu.GetCallbacks(), "Board: MMC rev. B1" NST_LINEBREAK ); break;
+					case REV_B2: Log::Flush( cpu.GetCallbacks(), "Board: MMC rev. B2" NST_LINEBREAK ); break;
+					case REV_B3: Log::Flush( cpu.GetCallbacks(), "Board: MMC rev. B3" NST_LINEBREAK ); break;
 				}
 			}
 
@@ -43,9 +43,9 @@ namespace Nes
 			{
 				switch (revision)
 				{
-					case Mmc3::REV_A: Log::Flush( "Board: MMC rev. A" NST_LINEBREAK ); break;
-					case Mmc3::REV_B: Log::Flush( "Board: MMC rev. B" NST_LINEBREAK ); break;
-					case Mmc3::REV_C: Log::Flush( "Board: MMC rev. C" NST_LINEBREAK ); break;
+					case Mmc3::REV_A: Log::Flush( cpu.GetCallbacks(), "Board: MMC rev. A" NST_LINEBREAK ); break;
+					case Mmc3::REV_B: Log::Flush( cpu.GetCallbacks(), "Board: MMC rev. B" NST_LINEBREAK ); break;
+					case Mmc3::REV_C: Log::Flush( cpu.GetCallbacks(), "Board: MMC rev. C" NST_LINEBREAK ); break;
 				}
 			}
 
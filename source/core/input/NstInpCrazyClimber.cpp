@@ -24,6 +24,7 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpCrazyClimber.hpp"
+#include "../NstCpu.hpp"
 
 namespace Nes
 {
@@ -87,7 +88,7 @@ namespace Nes
 						Controllers::CrazyClimber& crazy = input->crazyClimber;
 						input = NULL;
 
-						if (Controllers::CrazyClimber::callback( crazy ))
+						if (cpu.GetCallbacks()[Controllers::CrazyClimber::callback]( crazy ))
 						{
 							state[LEFT] = crazy.left;
 							state[RIGHT] = crazy.right;
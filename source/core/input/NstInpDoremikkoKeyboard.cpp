@@ -24,6 +24,7 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpDoremikkoKeyboard.hpp"
+#include "../NstCpu.hpp"
 
 namespace Nes
 {
@@ -83,7 +84,7 @@ namespace Nes
 
 					if (input)
 					{
-						Controllers::DoremikkoKeyboard::callback( input->doremikkoKeyboard, part, port );
+						cpu.GetCallbacks()[Controllers::DoremikkoKeyboard::callback]( input->doremikkoKeyboard, part, port );
 						return input->doremikkoKeyboard.keys & 0x1E;
 					}
 				}
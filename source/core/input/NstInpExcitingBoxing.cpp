@@ -24,6 +24,7 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpExcitingBoxing.hpp"
+#include "../NstCpu.hpp"
 
 namespace Nes
 {
@@ -59,7 +60,7 @@ namespace Nes
 			{
 				if (input)
 				{
-					Controllers::ExcitingBoxing::callback( input->excitingBoxing, data & 0x2 );
+					cpu.GetCallbacks()[Controllers::ExcitingBoxing::callback]( input->excitingBoxing, data & 0x2 );
 					state = ~input->excitingBoxing.buttons & 0x1E;
 				}
 				else
@@ -158,7 +158,7 @@ namespace Nes
 			}
 
 			FamilyKeyboard::DataRecorder::DataRecorder(Cpu& c)
-			: cycles(0), cpu(c), multiplier(0), clock(0), status(STOPPED), pos(0), in(0), out(0)
+			: cycles(0), cpu(c), multiplier(0), clock(0), status(STOPPED), pos(0), in(0), out(0), file(c.GetCallbacks())
 			{
 				file.Load( File::TAPE, stream, MAX_LENGTH );
 			}
@@ -415,7 +415,7 @@ namespace Nes
 
 				cpu.AddHook( Hook(this,&DataRecorder::Hook_Tape) );
 
-				Api::TapeRecorder::eventCallback( status == PLAYING ? Api::TapeRecorder::EVENT_PLAYING : Api::TapeRecorder::EVENT_RECORDING );
+				cpu.GetCallbacks()[Api::TapeRecorder::eventCallback]( status == PLAYING ? Api::TapeRecorder::EVENT_PLAYING : Api::TapeRecorder::EVENT_RECORDING );
 			}
 
 			NST_NO_INLINE Result FamilyKeyboard::DataRecorder::Stop(const bool removeHook)
@@ -433,7 +433,7 @@ namespace Nes
 				out = 0;
 				pos = 0;
 
-				Api::TapeRecorder::eventCallback( Api::TapeRecorder::EVENT_STOPPED );
+				cpu.GetCallbacks()[Api::TapeRecorder::eventCallback]( Api::TapeRecorder::EVENT_STOPPED );
 
 				return RESULT_OK;
 			}
@@ -475,7 +475,7 @@ namespace Nes
 				}
 				else if (input && scan < 9)
 				{
-					Controllers::FamilyKeyboard::callback( input->familyKeyboard, scan, mode );
+					cpu.GetCallbacks()[Controllers::FamilyKeyboard::callback]( input->familyKeyboard, scan, mode );
 					return ~uint(input->familyKeyboard.parts[scan]) & 0x1E;
 				}
 				else
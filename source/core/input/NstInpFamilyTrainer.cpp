@@ -24,6 +24,7 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpFamilyTrainer.hpp"
+#include "../NstCpu.hpp"
 
 namespace Nes
 {
@@ -67,7 +68,7 @@ namespace Nes
 				Controllers::FamilyTrainer& trainer = input->familyTrainer;
 				input = NULL;
 
-				if (Controllers::FamilyTrainer::callback( trainer ))
+				if (cpu.GetCallbacks()[Controllers::FamilyTrainer::callback]( trainer ))
 				{
 					static const word lut[Controllers::FamilyTrainer::NUM_SIDE_A_BUTTONS] =
 					{
@@ -24,6 +24,7 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpHoriTrack.hpp"
+#include "../NstCpu.hpp"
 
 namespace Nes
 {
@@ -92,7 +93,7 @@ namespace Nes
 						Controllers::HoriTrack& horiTrack = input->horiTrack;
 						input = NULL;
 
-						if (Controllers::HoriTrack::callback( horiTrack ))
+						if (cpu.GetCallbacks()[Controllers::HoriTrack::callback]( horiTrack ))
 						{
 							dword bits = (horiTrack.buttons & 0xFF) | CONNECTED;
 
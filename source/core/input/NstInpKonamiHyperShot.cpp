@@ -24,6 +24,7 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpKonamiHyperShot.hpp"
+#include "../NstCpu.hpp"
 
 namespace Nes
 {
@@ -69,7 +70,7 @@ namespace Nes
 
 				if (prev > strobe && input)
 				{
-					Controllers::KonamiHyperShot::callback( input->konamiHyperShot );
+					cpu.GetCallbacks()[Controllers::KonamiHyperShot::callback]( input->konamiHyperShot );
 					state = input->konamiHyperShot.buttons & 0x1E;
 					input = NULL;
 				}
@@ -24,6 +24,7 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpMahjong.hpp"
+#include "../NstCpu.hpp"
 
 namespace Nes
 {
@@ -61,7 +62,7 @@ namespace Nes
 
 				if (data && input)
 				{
-					Controllers::Mahjong::callback( input->mahjong, data );
+					cpu.GetCallbacks()[Controllers::Mahjong::callback]( input->mahjong, data );
 					stream = input->mahjong.buttons << 1;
 				}
 				else
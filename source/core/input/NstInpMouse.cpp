@@ -24,6 +24,7 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpMouse.hpp"
+#include "../NstCpu.hpp"
 
 namespace Nes
 {
@@ -92,7 +93,7 @@ namespace Nes
 						Controllers::Mouse& mouse = input->mouse;
 						input = NULL;
 
-						if (Controllers::Mouse::callback( mouse ))
+						if (cpu.GetCallbacks()[Controllers::Mouse::callback]( mouse ))
 						{
 							data = 0x00;
 
@@ -24,6 +24,7 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpOekaKidsTablet.hpp"
+#include "../NstCpu.hpp"
 
 namespace Nes
 {
@@ -77,7 +78,7 @@ namespace Nes
 						Controllers::OekaKidsTablet& tablet = input->oekaKidsTablet;
 						input = NULL;
 
-						if (Controllers::OekaKidsTablet::callback( tablet ))
+						if (cpu.GetCallbacks()[Controllers::OekaKidsTablet::callback]( tablet ))
 						{
 							if (tablet.x <= 255 && tablet.y <= 239)
 							{
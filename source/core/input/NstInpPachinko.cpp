@@ -24,6 +24,7 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpPachinko.hpp"
+#include "../NstCpu.hpp"
 
 namespace Nes
 {
@@ -92,7 +93,7 @@ namespace Nes
 						Controllers::Pachinko& pachinko = input->pachinko;
 						input = NULL;
 
-						if (Controllers::Pachinko::callback( pachinko ))
+						if (cpu.GetCallbacks()[Controllers::Pachinko::callback]( pachinko ))
 						{
 							uint throttle = Clamp<-64,+63>(pachinko.throttle) + 192;
 
@@ -99,7 +99,7 @@ namespace Nes
 					Controllers::Pad& pad = input->pad[type - Api::Input::PAD1];
 					input = NULL;
 
-					if (Controllers::Pad::callback( pad, type - Api::Input::PAD1 ))
+					if (cpu.GetCallbacks()[Controllers::Pad::callback]( pad, type - Api::Input::PAD1 ))
 					{
 						uint buttons = pad.buttons;
 
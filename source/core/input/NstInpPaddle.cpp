@@ -24,6 +24,7 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpPaddle.hpp"
+#include "../NstCpu.hpp"
 
 namespace Nes
 {
@@ -97,7 +98,7 @@ namespace Nes
 						Controllers::Paddle& paddle = input->paddle;
 						input = NULL;
 
-						if (Controllers::Paddle::callback( paddle ))
+						if (cpu.GetCallbacks()[Controllers::Paddle::callback]( paddle ))
 						{
 							data = 0xFF - ((82 + 172 * (Clamp<32,176>(paddle.x) - 32U) / 144) & 0xFF);
 
@@ -24,6 +24,7 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpPartyTap.hpp"
+#include "../NstCpu.hpp"
 
 namespace Nes
 {
@@ -69,7 +70,7 @@ namespace Nes
 				{
 					if (input)
 					{
-						Controllers::PartyTap::callback( input->partyTap );
+						cpu.GetCallbacks()[Controllers::PartyTap::callback]( input->partyTap );
 						state = input->partyTap.units;
 						input = NULL;
 					}
@@ -24,6 +24,7 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpPokkunMoguraa.hpp"
+#include "../NstCpu.hpp"
 
 namespace Nes
 {
@@ -59,7 +60,7 @@ namespace Nes
 			{
 				if (input)
 				{
-					Controllers::PokkunMoguraa::callback( input->pokkunMoguraa, ~data & 0x7 );
+					cpu.GetCallbacks()[Controllers::PokkunMoguraa::callback]( input->pokkunMoguraa, ~data & 0x7 );
 					state = ~input->pokkunMoguraa.buttons & 0x1E;
 				}
 				else
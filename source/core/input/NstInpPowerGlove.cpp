@@ -24,6 +24,7 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpPowerGlove.hpp"
+#include "../NstCpu.hpp"
 
 namespace Nes
 {
@@ -118,7 +119,7 @@ namespace Nes
 				Controllers::PowerGlove& glove = input->powerGlove;
 				input = NULL;
 
-				if (Controllers::PowerGlove::callback( glove ))
+				if (cpu.GetCallbacks()[Controllers::PowerGlove::callback]( glove ))
 				{
 					buffer[1] = (glove.x - 128U) & 0xFF;
 					buffer[2] = (128U - glove.y) & 0xFF;
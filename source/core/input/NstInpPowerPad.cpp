@@ -24,6 +24,7 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpPowerPad.hpp"
+#include "../NstCpu.hpp"
 
 namespace Nes
 {
@@ -85,7 +86,7 @@ namespace Nes
 						Controllers::PowerPad& power = input->powerPad;
 						input = NULL;
 
-						if (Controllers::PowerPad::callback( power ))
+						if (cpu.GetCallbacks()[Controllers::PowerPad::callback]( power ))
 						{
 							static const dword lut[Controllers::PowerPad::NUM_SIDE_A_BUTTONS] =
 							{
@@ -24,6 +24,7 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpSuborKeyboard.hpp"
+#include "../NstCpu.hpp"
 
 namespace Nes
 {
@@ -94,7 +95,7 @@ namespace Nes
 				}
 				else if (input && scan < 10)
 				{
-					Controllers::SuborKeyboard::callback( input->suborKeyboard, scan, mode );
+					cpu.GetCallbacks()[Controllers::SuborKeyboard::callback]( input->suborKeyboard, scan, mode );
 					return ~uint(input->suborKeyboard.parts[scan]) & 0x1E;
 				}
 				else
@@ -24,6 +24,7 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpTopRider.hpp"
+#include "../NstCpu.hpp"
 
 namespace Nes
 {
@@ -67,7 +68,7 @@ namespace Nes
 			{
 				if (controllers)
 				{
-					Controllers::TopRider::callback( controllers->topRider );
+					cpu.GetCallbacks()[Controllers::TopRider::callback]( controllers->topRider );
 
 					uint data = controllers->topRider.buttons;
 
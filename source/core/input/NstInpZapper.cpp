@@ -25,6 +25,7 @@
 #include "NstInpDevice.hpp"
 #include "../NstPpu.hpp"
 #include "NstInpZapper.hpp"
+#include "../NstCpu.hpp"
 
 namespace Nes
 {
@@ -169,7 +170,7 @@ namespace Nes
 					Controllers::Zapper& zapper = input->zapper;
 					input = NULL;
 
-					if (Controllers::Zapper::callback( zapper ))
+					if (cpu.GetCallbacks()[Controllers::Zapper::callback]( zapper ))
 					{
 						fire = (zapper.fire ? arcade ? 0x80 : 0x10 : 0x00);
 
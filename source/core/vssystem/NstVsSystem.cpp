@@ -225,13 +225,13 @@ namespace Nes
 		#pragma optimize("", on)
 		#endif
 
-		void Cartridge::VsSystem::VsDipSwitches::BeginFrame(Input::Controllers* const input)
+		void Cartridge::VsSystem::VsDipSwitches::BeginFrame(Input::Controllers* const input,const UserCallbacks& callbacks)
 		{
 			if (!coinTimer)
 			{
 				if (input)
 				{
-					Input::Controllers::VsSystem::callback( input->vsSystem );
+					callbacks[Input::Controllers::VsSystem::callback]( input->vsSystem );
 
 					if (input->vsSystem.insertCoin & COIN)
 					{
@@ -1357,9 +1357,10 @@ namespace Nes
 			}
 		};
 
-		void Cartridge::VsSystem::InputMapper::Begin(const Api::Input input,Input::Controllers* const controllers)
+		void Cartridge::VsSystem::InputMapper::Begin(const Api::Input input,Input::Controllers* const controllers,UserCallbacks& callbacks)
 		{
-			Input::Controllers::Pad::callback.Get( userCallback, userData );
+			overridden = callbacks.IsSet( Input::Controllers::Pad::callback );
+			callbacks[Input::Controllers::Pad::callback].Get( userCallback, userData );
 
 			if (controllers)
 			{
@@ -1370,18 +1371,21 @@ namespace Nes
 					ports[i] = input.GetConnectedController(i) - Api::Input::PAD1;
 
 					if (ports[i] < 4)
-						Input::Controllers::Pad::callback( controllers->pad[ports[i]], ports[i] );
+						callbacks[Input::Controllers::Pad::callback]( controllers->pad[ports[i]], ports[i] );
 				}
 
-				Input::Controllers::Pad::callback.Set( NULL, NULL );
+				callbacks.Set( Input::Controllers::Pad::callback, NULL, NULL );
 
 				Fix( controllers->pad, ports );
 			}
 		}
 
-		void Cartridge::VsSystem::InputMapper::End() const
+		void Cartridge::VsSystem::InputMapper::End(UserCallbacks& callbacks) const
 		{
-			Input::Controllers::Pad::callback.Set( userCallback, userData );
+			if (overridden)
+				callbacks.Set( Input::Controllers::Pad::callback, userCallback, userData );
+			else
+				callbacks.Unset( Input::Controllers::Pad::callback );
 		}
 
 		#ifdef NST_MSVC_OPTIMIZE
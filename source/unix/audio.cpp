@@ -42,6 +42,68 @@ static uint32_t outputbufsize;
 
 int framerate, channels;
 
+// Dynamic rate control: the number of samples requested from the core each
+// frame is nudged by up to DRC_MAX_DEVIATION so the queue settles around
+// DRC_TARGET_FRAMES worth of audio instead of slowly draining or piling up.
+#define DRC_MAX_DEVIATION 0.005
+#define DRC_TARGET_FRAMES 2
+
+static double drc_remainder = 0.0;
+
+// Single producer (emulation thread), single consumer (SDL audio thread)
+// ring buffer. The read and write positions are free running frame counts,
+// each only ever stored by its own side, so no lock is needed.
+#define RING_LENGTH_MS 100
+
+static int16_t *ringbuf;
+static uint32_t ringframes; // Power of two
+static SDL_atomic_t ringread, ringwrite;
+static SDL_atomic_t underruns, overruns;
+
+static void ring_init(int rate) {
+	ringframes = 1;
+	
+	while (ringframes < (uint32_t)(rate * RING_LENGTH_MS / 1000)) {
+		ringframes <<= 1;
+	}
+	
+	ringbuf = (int16_t *)malloc(ringframes * channels * sizeof(int16_t));
+	memset(ringbuf, 0, ringframes * channels * sizeof(int16_t));
+	
+	SDL_AtomicSet(&ringread, 0);
+	SDL_AtomicSet(&ringwrite, 0);
+	SDL_AtomicSet(&underruns, 0);
+	SDL_AtomicSet(&overruns, 0);
+}
+
+static uint32_t ring_count() {
+	// Number of frames waiting to be played
+	return (uint32_t)SDL_AtomicGet(&ringwrite) - (uint32_t)SDL_AtomicGet(&ringread);
+}
+
+static void ring_write(const int16_t *src, uint32_t frames) {
+	// Called from the emulation thread only
+	uint32_t write = (uint32_t)SDL_AtomicGet(&ringwrite);
+	uint32_t space = ringframes - (write - (uint32_t)SDL_AtomicGet(&ringread));
+	
+	if (frames > space) {
+		// Drop what doesn't fit, as happens when running at the alternate speed
+		SDL_AtomicAdd(&overruns, 1);
+		frames = space;
+	}
+	
+	for (uint32_t i = 0; i < frames; i++) {
+		uint32_t pos = (write + i) & (ringframes - 1);
+		
+		for (int ch = 0; ch < channels; ch++) {
+			ringbuf[pos * channels + ch] = src[i * channels + ch];
+		}
+	}
+	
+	// SDL_AtomicSet is a full barrier, the samples are visible before the position
+	SDL_AtomicSet(&ringwrite, (int)(write + frames));
+}
+
 void audio_init() {
 	// Initialize audio device
 	
@@ -50,21 +112,24 @@ void audio_init() {
 	
 	channels = conf.audio_stereo ? 2 : 1;
 	
-	outputbufsize = 2 * channels * (conf.audio_sample_rate / framerate);
+	// Leave headroom for the rate control adjustments
+	outputbufsize = 2 * channels * (conf.audio_sample_rate / framerate) * 2;
 	
 	audiobuf = (int16_t *)malloc(outputbufsize);
 	memset(audiobuf, 0, outputbufsize);
 	
 	if (conf.audio_api == 0) { // SDL
+		ring_init(conf.audio_sample_rate);
+		
 		spec.freq = conf.audio_sample_rate;
 		spec.format = AUDIO_S16SYS;
 		spec.channels = channels;
 		spec.silence = 0;
-		spec.samples = conf.audio_sample_rate / framerate;
+		spec.samples = 512;
 		spec.userdata = 0;
 		spec.callback = audio_callback;
 		
-		dev = SDL_OpenAudioDevice(NULL, 0, &spec, &obtained, SDL_AUDIO_ALLOW_ANY_CHANGE);
+		dev = SDL_OpenAudioDevice(NULL, 0, &spec, &obtained, 0);
 		if (!dev) {
 			fprintf(stderr, "Error opening audio device.\n");
 		}
@@ -119,28 +184,88 @@ void audio_set_params(Sound::Output *soundoutput) {
 	sound.SetSpeaker(conf.audio_stereo ? Sound::SPEAKER_STEREO : Sound::SPEAKER_MONO);
 	sound.SetSpeed(Sound::DEFAULT_SPEED);
 	
+	drc_remainder = 0.0;
+	
 	soundoutput->samples[0] = audiobuf;
 	soundoutput->length[0] = conf.audio_sample_rate / framerate;
 	soundoutput->samples[1] = NULL;
 	soundoutput->length[1] = 0;
 }
 
+int audio_queued() {
+	// Return the number of sample frames waiting to be played
+	if (conf.audio_api == 0 && dev) { // SDL
+		return ring_count();
+	}
+	
+	return -1;
+}
+
+void audio_get_stats(unsigned *underrun_count, unsigned *overrun_count) {
+	// Report how many times the ring buffer ran dry or overflowed
+	*underrun_count = SDL_AtomicGet(&underruns);
+	*overrun_count = SDL_AtomicGet(&overruns);
+}
+
 void audio_callback(void *userdata, Uint8 *stream, int len) {
-	// Audio callback for SDL
-	int i;
-	Uint8 *outputbuf = (Uint8*)audiobuf;
+	// Audio callback for SDL, runs on the audio thread
+	int16_t *out = (int16_t *)stream;
+	uint32_t frames = len / (2 * channels);
+	uint32_t read = (uint32_t)SDL_AtomicGet(&ringread);
+	uint32_t avail = (uint32_t)SDL_AtomicGet(&ringwrite) - read;
+	uint32_t count = avail < frames ? avail : frames;
 	
-	SDL_memset(stream, 0, len);
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t pos = (read + i) & (ringframes - 1);
+		
+		for (int ch = 0; ch < channels; ch++) {
+			out[i * channels + ch] = ringbuf[pos * channels + ch];
+		}
+	}
 	
-	for (i = 0; i < len; i++) {
-		stream[i] = outputbuf[i];
+	if (count < frames) {
+		// Only count underruns once the emulator has started producing
+		if (read + avail) {
+			SDL_AtomicAdd(&underruns, 1);
+		}
+		
+		SDL_memset(out + count * channels, 0, (frames - count) * 2 * channels);
+	}
+	
+	SDL_AtomicSet(&ringread, (int)(read + count));
+}
+
+void audio_adjust(Sound::Output *soundoutput) {
+	// Set the number of samples to request for the next frame
+	double base = (double)conf.audio_sample_rate / framerate;
+	double want = base;
+	int queued = audio_queued();
+	
+	if (queued >= 0) {
+		// Positive when the queue is below target, negative when above
+		double delta = (DRC_TARGET_FRAMES * base - queued) / (DRC_TARGET_FRAMES * base);
+		
+		if (delta > 1.0) { delta = 1.0; }
+		if (delta < -1.0) { delta = -1.0; }
+		
+		want = base * (1.0 + DRC_MAX_DEVIATION * delta);
 	}
+	
+	want += drc_remainder;
+	
+	int length = (int)want;
+	drc_remainder = want - length;
+	
+	soundoutput->length[0] = length;
 }
 
-void audio_play() {
+void audio_play(Sound::Output *soundoutput) {
 	
-	if (conf.audio_api == 1) { // libao
-		int bufsize = 2 * channels * (conf.audio_sample_rate / framerate);
+	if (conf.audio_api == 0) { // SDL
+		ring_write(audiobuf, soundoutput->length[0]);
+	}
+	else if (conf.audio_api == 1) { // libao
+		int bufsize = 2 * channels * soundoutput->length[0];
 		ao_play(device, (char*)audiobuf, bufsize);
 	}
 }
@@ -158,6 +283,22 @@ void audio_deinit() {
 	
 	if (conf.audio_api == 0) { // SDL
 		SDL_CloseAudioDevice(dev);
+		
+		// Report once per session, deinit runs again at exit after a pause
+		if (ringbuf) {
+			unsigned underrun_count, overrun_count;
+			audio_get_stats(&underrun_count, &overrun_count);
+			
+			if (underrun_count || overrun_count) {
+				fprintf(stderr, "Audio: %u underrun(s), %u overrun(s)\n", underrun_count, overrun_count);
+			}
+			
+			SDL_AtomicSet(&underruns, 0);
+			SDL_AtomicSet(&overruns, 0);
+			
+			free(ringbuf);
+			ringbuf = NULL;
+		}
 	}
 	else if (conf.audio_api == 1) { // libao
 		ao_close(device);
@@ -166,8 +307,7 @@ void audio_deinit() {
 }
 
 // Timing functions
-int currtick = 0;
-int lasttick = 0;
+static Uint64 nexttick = 0;
 
 void timing_set_default() {
 	// Set the framerate to the default
@@ -190,12 +330,21 @@ bool timing_check() {
 		return true;
 	}
 	
-	currtick = SDL_GetTicks();
+	// Pace frames against the high resolution counter, carrying the
+	// deadline forward so the rate doesn't drift from rounding
+	Uint64 currtick = SDL_GetPerformanceCounter();
+	Uint64 period = SDL_GetPerformanceFrequency() / framerate;
 	
-	if (currtick > (lasttick + (1000 / framerate))) {
-		lasttick = currtick;
-		return true;
+	if (currtick < nexttick) {
+		return false;
+	}
+	
+	nexttick += period;
+	
+	// Don't try to catch up after a stall
+	if (nexttick < currtick) {
+		nexttick = currtick + period;
 	}
 	
-	return false;
+	return true;
 }
@@ -10,8 +10,11 @@ using namespace Nes::Api;
 void audio_init();
 void audio_set_params(Sound::Output *soundoutput);
 void audio_unpause();
-void audio_play();
+int audio_queued();
+void audio_adjust(Sound::Output *soundoutput);
+void audio_play(Sound::Output *soundoutput);
 void audio_callback(void *userdata, Uint8 *stream, int len);
+void audio_get_stats(unsigned *underrun_count, unsigned *overrun_count);
 void audio_deinit();
 
 void timing_set_default();
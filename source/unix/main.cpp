@@ -135,11 +135,12 @@ static void NST_CALLBACK VideoUnlock(void* userData, Video::Output& video) {
 }
 
 static bool NST_CALLBACK SoundLock(void* userData, Sound::Output& sound) {
+	audio_adjust(&sound);
 	return true;
 }
 
 static void NST_CALLBACK SoundUnlock(void* userData, Sound::Output& sound) {
-	audio_play();
+	audio_play(&sound);
 }
 
 static void nst_unload(void) {
@@ -737,6 +738,8 @@ int main(int argc, char *argv[]) {
 	TTF_Quit();
 
 	nst_unload();
+	
+	video_deinit();
 
 	fileio_shutdown();
 	
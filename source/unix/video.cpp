@@ -51,9 +51,121 @@ Video::RenderState renderstate;
 
 dimensions basesize, rendersize;
 
+static Nes::dword texhash[2];
+static bool texvalid = false;
+
+// filter worker pool, the emulation thread takes bands alongside the workers
+#define BLIT_MAX_THREADS 4
+
+static SDL_mutex *blitmutex = NULL;
+static SDL_cond *blitstart, *blitdone;
+static SDL_Thread *blitthreads[BLIT_MAX_THREADS - 1];
+static int blitworkers = 0;
+static Nes::Core::Video::Output::Job blitjob;
+static void *blitcontext;
+static unsigned blitcount, blitnext, blitpending, blitgeneration;
+static bool blitquit;
+
 extern settings conf;
 extern Emulator emulator;
 
+static void video_blit_run() {
+	// called with blitmutex held
+	while (blitnext < blitcount) {
+		unsigned index = blitnext++;
+		SDL_UnlockMutex(blitmutex);
+		blitjob(blitcontext, index);
+		SDL_LockMutex(blitmutex);
+		
+		if (--blitpending == 0) { SDL_CondBroadcast(blitdone); }
+	}
+}
+
+static int video_blit_worker(void*) {
+	SDL_LockMutex(blitmutex);
+	
+	unsigned generation = blitgeneration;
+	
+	for (;;) {
+		while (generation == blitgeneration && !blitquit) {
+			SDL_CondWait(blitstart, blitmutex);
+		}
+		
+		if (blitquit) { break; }
+		
+		generation = blitgeneration;
+		video_blit_run();
+	}
+	
+	SDL_UnlockMutex(blitmutex);
+	return 0;
+}
+
+static void NST_CALLBACK video_blit_dispatch(void*, Nes::Core::Video::Output::Job job, void *context, unsigned count) {
+	SDL_LockMutex(blitmutex);
+	
+	blitjob = job;
+	blitcontext = context;
+	blitcount = count;
+	blitnext = 0;
+	blitpending = count;
+	++blitgeneration;
+	
+	SDL_CondBroadcast(blitstart);
+	video_blit_run();
+	
+	while (blitpending) {
+		SDL_CondWait(blitdone, blitmutex);
+	}
+	
+	SDL_UnlockMutex(blitmutex);
+}
+
+static void video_blit_pool_init() {
+	// start one worker less than there are CPUs, the caller makes up the rest
+	if (blitmutex) { return; }
+	
+	int threads = SDL_GetCPUCount();
+	
+	if (threads > BLIT_MAX_THREADS) { threads = BLIT_MAX_THREADS; }
+	
+	blitmutex = SDL_CreateMutex();
+	blitstart = SDL_CreateCond();
+	blitdone = SDL_CreateCond();
+	blitquit = false;
+	
+	while (blitworkers < threads - 1) {
+		blitthreads[blitworkers] = SDL_CreateThread(video_blit_worker, "nstblit", NULL);
+		
+		if (!blitthreads[blitworkers]) { break; }
+		
+		blitworkers++;
+	}
+	
+	Nes::Core::Video::Output::dispatchCallback.Set(video_blit_dispatch, NULL);
+}
+
+void video_deinit() {
+	// stop the filter worker pool
+	if (!blitmutex) { return; }
+	
+	Nes::Core::Video::Output::dispatchCallback.Unset();
+	
+	SDL_LockMutex(blitmutex);
+	blitquit = true;
+	SDL_CondBroadcast(blitstart);
+	SDL_UnlockMutex(blitmutex);
+	
+	while (blitworkers) {
+		SDL_WaitThread(blitthreads[--blitworkers], NULL);
+	}
+	
+	SDL_DestroyCond(blitdone);
+	SDL_DestroyCond(blitstart);
+	SDL_DestroyMutex(blitmutex);
+	blitmutex = NULL;
+}
+
 void opengl_init_structures() {
 	// init OpenGL and set up for blitting
 	int scalefactor = conf.video_scale_factor;
@@ -63,6 +175,8 @@ void opengl_init_structures() {
 	
 	glEnable( GL_TEXTURE_2D );
 	
+	texvalid = false;
+	
 	glGenTextures( 1, &screenTexID ) ;
 	glBindTexture( GL_TEXTURE_2D, screenTexID ) ;
 	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, conf.video_linear_filter ? GL_LINEAR : GL_NEAREST) ;
@@ -104,15 +218,28 @@ void opengl_cleanup() {
 }
 
 void opengl_blit() {
-	// blit the image using OpenGL
-	glTexImage2D(GL_TEXTURE_2D,
-				0,
-				GL_RGBA,
-				basesize.w, basesize.h,
-				0,
-				GL_BGRA,
-				GL_UNSIGNED_BYTE,
-		videobuf);
+	// blit the image using OpenGL, the texture is only uploaded if the frame changed
+	Video video(emulator);
+	Nes::dword hash[2];
+	const bool hashed = NES_SUCCEEDED(video.GetFrameHash(hash));
+	
+	if (!hashed || !texvalid || hash[0] != texhash[0] || hash[1] != texhash[1]) {
+		glTexImage2D(GL_TEXTURE_2D,
+					0,
+					GL_RGBA,
+					basesize.w, basesize.h,
+					0,
+					GL_BGRA,
+					GL_UNSIGNED_BYTE,
+			videobuf);
+	}
+	
+	texvalid = hashed;
+	
+	if (hashed) {
+		texhash[0] = hash[0];
+		texhash[1] = hash[1];
+	}
 
 	glBegin( GL_QUADS ) ;
 		glTexCoord2f(1.0f, 1.0f);
@@ -140,8 +267,11 @@ void video_init() {
 	
 	opengl_init_structures();
 	
+	video_blit_pool_init();
+	
 	// Set up the render state parameters
 	renderstate.filter = filter;
+	renderstate.threads = blitworkers + 1;
 	renderstate.width = basesize.w;
 	renderstate.height = basesize.h;
 	renderstate.bits.count = 32;
@@ -234,6 +364,9 @@ void video_init() {
 		video.SetBlend(conf.video_xbr_pixel_blending);
 	}
 	
+	// keep filtered NTSC lines, unmerged fields repeat their burst phase every third frame
+	video.EnableNtscRowCache(conf.video_filter == 1);
+	
 	video.ClearFilterUpdateFlag();
 	
 	// set the render state
@@ -241,6 +374,14 @@ void video_init() {
 		fprintf(stderr, "Nestopia core rejected render state\n");
 		exit(1);
 	}
+	
+	// videobuf keeps its contents between frames, restart line tracking for the new buffer
+	video.EnablePersistentOutput(false);
+	video.EnablePersistentOutput(true);
+	
+	// hash frames so unchanged ones are not uploaded again
+	video.EnableFrameHash(true);
+	texvalid = false;
 }
 
 void video_toggle_fullscreen() {
@@ -19,6 +19,7 @@ void opengl_cleanup();
 void opengl_blit();
 
 void video_init();
+void video_deinit();
 void video_create();
 void video_destroy();
 void video_toggle_fullscreen();